@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include "knapsack_trace.h"
 
 typedef struct {
     int id;
@@ -39,8 +40,21 @@ int compare(const void* a, const void* b) {
     return (r1 < r2) - (r1 > r2);
 }
 
+#ifdef KNAPSACK_TRACE
+// ʽڵ㡢޼Ľڵ㡢޼Ž´
+typedef struct {
+    long long nodes;
+    long long pruned;
+    long long bound_evals;
+    long long incumbent_updates;
+} BacktrackCounters;
+
+static BacktrackCounters bt_counters;
+#endif
+
 // ޺
 float bound(Item* items, int level, int n, int weight, float value, int capacity) {
+    TRACE_INC(bt_counters.bound_evals);
     float bound_val = value;
     int remain = capacity - weight;
     for (int i = level; i < n && remain > 0; i++) {
@@ -63,10 +77,13 @@ typedef struct {
 // 
 void backtrack(Item* items, int level, int n, int weight, float value,
                int capacity, int* current_selected, Solution* best) {
+    TRACE_INC(bt_counters.nodes);
     if (level == n) {
         if (weight <= capacity && value > best->value) {
             best->value = value;
             memcpy(best->selected, current_selected, n * sizeof(int));
+            TRACE_INC(bt_counters.incumbent_updates);
+            TRACE_INSTANT("incumbent", "value", value);
         }
         return;
     }
@@ -82,21 +99,34 @@ void backtrack(Item* items, int level, int n, int weight, float value,
     current_selected[level] = 0;
     if (bound(items, level + 1, n, weight, value, capacity) > best->value) {
         backtrack(items, level + 1, n, weight, value, capacity, current_selected, best);
+    } else {
+        TRACE_INC(bt_counters.pruned);
     }
 }
 
 // ̰û
 float knapsack_backtrack(Item* items, int n, int capacity, int* selected, int* total_weight) {
+    TRACE_PHASE_BEGIN(sort);
     Item* sorted = (Item*)malloc(n * sizeof(Item));
     memcpy(sorted, items, n * sizeof(Item));
     qsort(sorted, n, sizeof(Item), compare);
+    TRACE_PHASE_END(sort);
 
     Solution best;
     best.value = 0;
     best.selected = (int*)calloc(n, sizeof(int));
     int* current_selected = (int*)calloc(n, sizeof(int));
 
+#ifdef KNAPSACK_TRACE
+    memset(&bt_counters, 0, sizeof(bt_counters));
+#endif
+    TRACE_PHASE_BEGIN(search);
     backtrack(sorted, 0, n, 0, 0.0f, capacity, current_selected, &best);
+    TRACE_PHASE_END(search);
+    TRACE_COUNTER("nodes", bt_counters.nodes);
+    TRACE_COUNTER("pruned", bt_counters.pruned);
+    TRACE_COUNTER("bound_evals", bt_counters.bound_evals);
+    TRACE_COUNTER("incumbent_updates", bt_counters.incumbent_updates);
 
     // ѡƷӳԭʼƷ˳
     *total_weight = 0;
@@ -170,28 +200,35 @@ void print_text(FILE* fp, Item* items, int n, int* selected, int total_weight, i
     fprintf(fp, "------------------------\n\n");
 }
 
-int main() {
+// ÷: backtrack [n capacity]
+// ʱֻܵ (n, ) Ԫд׼ bench_runner е
+int main(int argc, char* argv[]) {
     srand((unsigned int)time(NULL));
+    int only_n = argc >= 3 ? atoi(argv[1]) : 0;
+    int only_capacity = argc >= 3 ? atoi(argv[2]) : 0;
 
     int sizes[] = {1000, 2000, 3000, 4000, 5000, 6000, 7000, 8000, 9000, 10000, 20000, 40000, 80000, 160000, 320000};
     int sizes_count = sizeof(sizes) / sizeof(int);
 
-    FILE* fp_txt = fopen("backtrack_results.txt", "w");
-    FILE* fp_xls = fopen("backtrack_1000.xls", "w");
-    if (!fp_txt || !fp_xls) {
+    FILE* fp_txt = only_n ? stdout : fopen("backtrack_results.txt", "w");
+    FILE* fp_xls = only_n ? NULL : fopen("backtrack_1000.xls", "w");
+    if (!fp_txt || (!only_n && !fp_xls)) {
         printf("ļʧܣ\n");
         return 1;
     }
 
     for (int si = 0; si < sizes_count; si++) {
         int n = sizes[si];
+        if (only_n && n != only_n) continue;
         Item* items = (Item*)malloc(n * sizeof(Item));
         int* selected = (int*)calloc(n, sizeof(int));
         generate_items(items, n);
 
         for (int ci = 0; ci < CAPACITIES; ci++) {
             int capacity = capacities[ci];
+            if (only_capacity && capacity != only_capacity) continue;
             int total_weight = 0;
+            TRACE_RUN_BEGIN("backtrack", n, capacity);
 
             // ݷ
             long long start = current_time_ms();
@@ -207,18 +244,31 @@ int main() {
             }
             long long end = current_time_ms();
 
+            TRACE_PHASE_BEGIN(output);
             print_text(fp_txt, items, n, selected, total_weight, capacity, total_value, end - start);
-            if (n == 1000 && total_value > 0) {
+            if (n == 1000 && total_value > 0 && fp_xls) {
                 print_excel(fp_xls, items, n, selected, total_weight, capacity, total_value);
             }
+            TRACE_PHASE_END(output);
+            TRACE_RUN_END();
         }
 
         free(items);
         free(selected);
     }
 
+    if (only_n) {
+        // Ԫģʽ trace ļ (n, ) ⲢеԪา
+        char json_path[64], chrome_path[64];
+        snprintf(json_path, sizeof(json_path), "backtrack_trace_%d_%d.json", only_n, only_capacity);
+        snprintf(chrome_path, sizeof(chrome_path), "backtrack_chrome_trace_%d_%d.json", only_n, only_capacity);
+        TRACE_EXPORT(json_path, chrome_path);
+        return 0;
+    }
+
     fclose(fp_txt);
     fclose(fp_xls);
+    TRACE_EXPORT("backtrack_trace.json", "backtrack_chrome_trace.json");
 
     printf("ݷɡ\n");
     return 0;
@@ -0,0 +1,429 @@
+// bench_runner.c
+// л׼ȣ (, Ʒ, ) Ԫɵ CPU ϲУ
+// ÿԪöӦĵԪģʽ ./dynamic_programming 1000 10000
+// ӽ̰󶨵߼ CPUΪһݱ档
+// Linux  fork + sched_setaffinityWindows  CreateProcess + SetProcessAffinityMask
+//
+// ÷: bench_runner [--isolate] [--jobs N] [--solvers dp,backtrack,greedy] [--out ļ]
+//   --isolate  ÿֻһ߼ CPUֵֿܱ߳Уʱɾ
+//   --jobs N   ͬʱ N ԪĬϵڿ CPU 
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <io.h>
+    typedef HANDLE Process;
+    #define NO_PROCESS NULL
+#else
+    #include <sched.h>
+    #include <unistd.h>
+    #include <sys/types.h>
+    #include <sys/wait.h>
+    typedef pid_t Process;
+    #define NO_PROCESS 0
+#endif
+
+#define MAX_CPUS 1024
+#define MAX_CELLS 256
+#define CAPACITIES 3
+const int capacities[CAPACITIES] = {10000, 100000, 1000000};
+const int sizes[] = {1000, 2000, 3000, 4000, 5000, 6000, 7000, 8000, 9000, 10000,
+                     20000, 40000, 80000, 160000, 320000};
+
+typedef struct {
+    const char* name;     // е
+    const char* program;  // Ԫģʽִļ
+} Solver;
+
+const Solver solvers[] = {
+#ifdef _WIN32
+    {"dp", "dynamic_programming.exe"},
+    {"backtrack", "backtrack.exe"},
+    {"greedy", "greedy.exe"},
+#else
+    {"dp", "./dynamic_programming"},
+    {"backtrack", "./backtrack"},
+    {"greedy", "./greedy"},
+#endif
+};
+#define SOLVER_COUNT ((int)(sizeof(solvers) / sizeof(Solver)))
+
+typedef struct {
+    const Solver* solver;
+    int n;
+    int capacity;
+    double cost;          // Ԥ
+    int cpu;              // ʵڵ߼ CPU
+    int status;           // ӽ˳룬-1 ʾ쳣ֹ
+    long long start_ms;
+    long long wall_ms;
+    FILE* output;         // ӽ̱׼ʱļ
+} Cell;
+
+// ȡǰʱ䣨ms
+long long current_time_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Կģͣdp  n* ȣ n log n 
+double estimate_cost(const Solver* solver, int n, int capacity) {
+    if (strcmp(solver->name, "dp") == 0) return (double)n * capacity;
+    return (double)n * log2((double)n);
+}
+
+// ĵԪܣβСԪգLPT ȣ
+int compare_cost(const void* a, const void* b) {
+    double c1 = ((const Cell*)a)->cost;
+    double c2 = ((const Cell*)b)->cost;
+    return (c1 < c2) - (c1 > c2);
+}
+
+// 水   Ʒ   У봮ɨ˳һ
+int compare_matrix(const void* a, const void* b) {
+    const Cell* x = (const Cell*)a;
+    const Cell* y = (const Cell*)b;
+    if (x->solver != y->solver) return x->solver < y->solver ? -1 : 1;
+    if (x->n != y->n) return x->n < y->n ? -1 : 1;
+    return (x->capacity > y->capacity) - (x->capacity < y->capacity);
+}
+
+#ifndef _WIN32
+// ȡ߼ CPU ˱ţʧʱ -1
+int read_topology(int cpu, const char* field) {
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, field);
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL) return -1;
+    int value = -1;
+    if (fscanf(fp, "%d", &value) != 1) value = -1;
+    fclose(fp);
+    return value;
+}
+#endif
+
+// ռʹõ߼ CPUisolate ʱÿֻСһ
+int collect_cpus(int* cpus, int isolate) {
+    int count = 0;
+#ifdef _WIN32
+    DWORD_PTR allowed, system_mask;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &allowed, &system_mask)) {
+        fprintf(stderr, "GetProcessAffinityMask ʧ: %lu\n", GetLastError());
+        exit(1);
+    }
+    DWORD_PTR chosen = allowed;
+    if (isolate) {
+        // ÿ RelationProcessorCore ĿӦһˣProcessorMask ȫ߼ CPU
+        DWORD bytes = 0;
+        GetLogicalProcessorInformation(NULL, &bytes);
+        SYSTEM_LOGICAL_PROCESSOR_INFORMATION* info = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION*)malloc(bytes);
+        if (info != NULL && GetLogicalProcessorInformation(info, &bytes)) {
+            chosen = 0;
+            int entries = (int)(bytes / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+            for (int i = 0; i < entries; i++) {
+                if (info[i].Relationship != RelationProcessorCore) continue;
+                DWORD_PTR core = info[i].ProcessorMask & allowed;
+                chosen |= core & (~core + 1);  // ȡúλ߼ CPU
+            }
+        }
+        free(info);
+    }
+    for (int cpu = 0; cpu < (int)(8 * sizeof(DWORD_PTR)) && count < MAX_CPUS; cpu++) {
+        if (chosen & ((DWORD_PTR)1 << cpu)) cpus[count++] = cpu;
+    }
+#else
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        perror("sched_getaffinity");
+        exit(1);
+    }
+    int packages[MAX_CPUS];
+    int cores[MAX_CPUS];
+    for (int cpu = 0; cpu < CPU_SETSIZE && count < MAX_CPUS; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed)) continue;
+        int package = read_topology(cpu, "physical_package_id");
+        int core = read_topology(cpu, "core_id");
+        int duplicate = 0;
+        for (int i = 0; isolate && core >= 0 && i < count; i++) {
+            if (packages[i] == package && cores[i] == core) {
+                duplicate = 1;
+                break;
+            }
+        }
+        if (duplicate) continue;
+        packages[count] = package;
+        cores[count] = core;
+        cpus[count++] = cpu;
+    }
+#endif
+    return count;
+}
+
+// ԪõʱļرպԶɾ
+FILE* open_cell_output(void) {
+#ifdef _WIN32
+    // msvcrt  tmpfile() Ŀ¼£ͨûûдȨޣ %TEMP% µļ
+    char dir[MAX_PATH], path[MAX_PATH];
+    if (GetTempPathA(MAX_PATH, dir) == 0 || GetTempFileNameA(dir, "knc", 0, path) == 0) return NULL;
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+    int fd = _open_osfhandle((intptr_t)file, 0);
+    if (fd < 0) {
+        CloseHandle(file);
+        return NULL;
+    }
+    FILE* fp = _fdopen(fd, "w+b");
+    if (fp == NULL) _close(fd);
+    return fp;
+#else
+    return tmpfile();
+#endif
+}
+
+// ָ CPU Ԫ׼ضʱļ
+Process launch_cell(Cell* cell, int cpu) {
+    cell->output = open_cell_output();
+    if (cell->output == NULL) {
+        fprintf(stderr, "޷Ԫʱļ\n");
+        exit(1);
+    }
+    cell->cpu = cpu;
+    cell->start_ms = current_time_ms();
+    fflush(NULL);
+
+#ifdef _WIN32
+    // ȹ𴴽ú׺ٻָ֤ӽ̴ӵһָָ CPU 
+    char command[256];
+    snprintf(command, sizeof(command), "%s %d %d", cell->solver->program, cell->n, cell->capacity);
+    HANDLE output = (HANDLE)_get_osfhandle(_fileno(cell->output));
+    SetHandleInformation(output, HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT);
+
+    STARTUPINFOA startup;
+    PROCESS_INFORMATION process;
+    memset(&startup, 0, sizeof(startup));
+    startup.cb = sizeof(startup);
+    startup.dwFlags = STARTF_USESTDHANDLES;
+    startup.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+    startup.hStdOutput = output;
+    startup.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+    BOOL created = CreateProcessA(NULL, command, NULL, NULL, TRUE, CREATE_SUSPENDED, NULL, NULL, &startup, &process);
+    SetHandleInformation(output, HANDLE_FLAG_INHERIT, 0);  // úԪ̳бԪļ
+    if (!created) {
+        fprintf(stderr, "޷ %s: %lu\n", cell->solver->program, GetLastError());
+        exit(1);
+    }
+    if (!SetProcessAffinityMask(process.hProcess, (DWORD_PTR)1 << cpu)) {
+        fprintf(stderr, "SetProcessAffinityMask ʧ: %lu\n", GetLastError());
+    }
+    ResumeThread(process.hThread);
+    CloseHandle(process.hThread);
+    return process.hProcess;
+#else
+    char n_arg[16], capacity_arg[16];
+    snprintf(n_arg, sizeof(n_arg), "%d", cell->n);
+    snprintf(capacity_arg, sizeof(capacity_arg), "%d", cell->capacity);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        exit(1);
+    }
+    if (pid == 0) {
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(cpu, &mask);
+        if (sched_setaffinity(0, sizeof(mask), &mask) != 0) perror("sched_setaffinity");
+        dup2(fileno(cell->output), STDOUT_FILENO);
+        execl(cell->solver->program, cell->solver->program, n_arg, capacity_arg, (char*)NULL);
+        perror(cell->solver->program);
+        _exit(127);
+    }
+    return pid;
+#endif
+}
+
+// ȴһеĵԪλд˳루쳣ֹΪ -1
+int wait_any(const Process* running, int slots, int* status) {
+#ifdef _WIN32
+    HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+    int slot_of[MAXIMUM_WAIT_OBJECTS];
+    DWORD count = 0;
+    for (int s = 0; s < slots; s++) {
+        if (running[s] == NO_PROCESS) continue;
+        handles[count] = running[s];
+        slot_of[count++] = s;
+    }
+    DWORD index = WaitForMultipleObjects(count, handles, FALSE, INFINITE);
+    if (index == WAIT_FAILED || index >= WAIT_OBJECT_0 + count) {
+        fprintf(stderr, "WaitForMultipleObjects ʧ: %lu\n", GetLastError());
+        exit(1);
+    }
+    int slot = slot_of[index - WAIT_OBJECT_0];
+    DWORD code;
+    *status = GetExitCodeProcess(running[slot], &code) ? (int)code : -1;
+    CloseHandle(running[slot]);
+    return slot;
+#else
+    while (1) {
+        int wstatus;
+        pid_t pid = wait(&wstatus);
+        if (pid < 0) {
+            perror("wait");
+            exit(1);
+        }
+        for (int s = 0; s < slots; s++) {
+            if (running[s] != pid) continue;
+            *status = WIFEXITED(wstatus) ? WEXITSTATUS(wstatus) : -1;
+            return s;
+        }
+    }
+#endif
+}
+
+// ȫԪ CPU һԪһӽ̽ CPU
+void run_cells(Cell* cells, int cell_count, const int* cpus, int slots) {
+    Process* running = (Process*)malloc(slots * sizeof(Process));
+    int* running_cell = (int*)calloc(slots, sizeof(int));
+    if (running == NULL || running_cell == NULL) {
+        perror("ڴʧ");
+        exit(1);
+    }
+    for (int s = 0; s < slots; s++) running[s] = NO_PROCESS;
+
+    int next = 0, active = 0;
+    while (next < cell_count || active > 0) {
+        for (int s = 0; s < slots && next < cell_count; s++) {
+            if (running[s] != NO_PROCESS) continue;
+            running[s] = launch_cell(&cells[next], cpus[s]);
+            running_cell[s] = next++;
+            active++;
+        }
+
+        int status;
+        int s = wait_any(running, slots, &status);
+        Cell* cell = &cells[running_cell[s]];
+        cell->wall_ms = current_time_ms() - cell->start_ms;
+        cell->status = status;
+        fprintf(stderr, "[%s n=%d C=%d] cpu %d, %lld ms%s\n", cell->solver->name, cell->n,
+                cell->capacity, cell->cpu, cell->wall_ms, cell->status ? "ʧ" : "");
+        running[s] = NO_PROCESS;
+        active--;
+    }
+
+    free(running);
+    free(running_cell);
+}
+
+// ܱ棺ǵԪٰܱ˳ϸԪԭʼ
+void print_report(FILE* fp, Cell* cells, int cell_count, int cpu_count, int isolate, long long elapsed_ms) {
+    long long serial_ms = 0;
+    for (int i = 0; i < cell_count; i++) serial_ms += cells[i].wall_ms;
+
+    fprintf(fp, "׼\n");
+    fprintf(fp, "ģʽ: %s,  CPU : %d, Ԫ: %d\n",
+            isolate ? "루ÿһԪ" : "ȫ߼ CPU", cpu_count, cell_count);
+    fprintf(fp, "ܺʱ: %lld ms, Ԫʱ֮: %lld ms, ٱ: %.2f\n",
+            elapsed_ms, serial_ms, elapsed_ms > 0 ? (double)serial_ms / elapsed_ms : 0.0);
+    fprintf(fp, "------------------------\n");
+    fprintf(fp, "\tƷ\t\tCPU\tʱ(ms)\t״̬\n");
+    for (int i = 0; i < cell_count; i++) {
+        fprintf(fp, "%s\t%d\t%d\t%d\t%lld\t%s\n", cells[i].solver->name, cells[i].n, cells[i].capacity,
+                cells[i].cpu, cells[i].wall_ms, cells[i].status == 0 ? "ɹ" : "ʧ");
+    }
+    fprintf(fp, "------------------------\n\n");
+
+    for (int i = 0; i < cell_count; i++) {
+        fprintf(fp, "[%s] Ʒ: %d, : %d\n", cells[i].solver->name, cells[i].n, cells[i].capacity);
+        if (cells[i].output == NULL) continue;
+        rewind(cells[i].output);
+        char buffer[4096];
+        size_t len;
+        while ((len = fread(buffer, 1, sizeof(buffer), cells[i].output)) > 0) fwrite(buffer, 1, len, fp);
+        fclose(cells[i].output);
+        cells[i].output = NULL;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int isolate = 0;
+    int jobs = 0;
+    const char* solver_list = "dp,backtrack,greedy";
+    const char* out_path = "bench_report.txt";
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--isolate") == 0) {
+            isolate = 1;
+        } else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            jobs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--solvers") == 0 && i + 1 < argc) {
+            solver_list = argv[++i];
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else {
+            fprintf(stderr, "÷: %s [--isolate] [--jobs N] [--solvers dp,backtrack,greedy] [--out ļ]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    int cpus[MAX_CPUS];
+    int cpu_count = collect_cpus(cpus, isolate);
+    if (jobs > 0 && jobs < cpu_count) cpu_count = jobs;
+#ifdef _WIN32
+    if (cpu_count > MAXIMUM_WAIT_OBJECTS) cpu_count = MAXIMUM_WAIT_OBJECTS;  // WaitForMultipleObjects 
+#endif
+    if (cpu_count <= 0) {
+        fprintf(stderr, "ûпõ CPU\n");
+        return 1;
+    }
+
+    // չ (, Ʒ, ) 
+    static Cell cells[MAX_CELLS];
+    int cell_count = 0;
+    int sizes_count = sizeof(sizes) / sizeof(int);
+    for (int k = 0; k < SOLVER_COUNT; k++) {
+        const char* found = strstr(solver_list, solvers[k].name);
+        size_t len = strlen(solvers[k].name);
+        if (found == NULL || (found != solver_list && found[-1] != ',') || (found[len] != ',' && found[len] != '\0')) {
+            continue;
+        }
+        for (int si = 0; si < sizes_count; si++) {
+            for (int ci = 0; ci < CAPACITIES && cell_count < MAX_CELLS; ci++) {
+                Cell* cell = &cells[cell_count++];
+                memset(cell, 0, sizeof(Cell));
+                cell->solver = &solvers[k];
+                cell->n = sizes[si];
+                cell->capacity = capacities[ci];
+                cell->cost = estimate_cost(cell->solver, cell->n, cell->capacity);
+                cell->cpu = -1;
+            }
+        }
+    }
+    if (cell_count == 0) {
+        fprintf(stderr, "ûƥ: %s\n", solver_list);
+        return 1;
+    }
+
+    qsort(cells, cell_count, sizeof(Cell), compare_cost);
+    long long start = current_time_ms();
+    run_cells(cells, cell_count, cpus, cpu_count);
+    long long end = current_time_ms();
+    qsort(cells, cell_count, sizeof(Cell), compare_matrix);
+
+    FILE* fp = fopen(out_path, "w");
+    if (fp == NULL) {
+        perror("޷ļ");
+        return 1;
+    }
+    print_report(fp, cells, cell_count, cpu_count, isolate, end - start);
+    fclose(fp);
+
+    printf("׼ɣ %d Ԫд %s\n", cell_count, out_path);
+    return 0;
+}
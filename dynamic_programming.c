@@ -2,6 +2,20 @@
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "knapsack_trace.h"
+
+#ifdef __AVX2__
+    #include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
 
 typedef struct {
     int id;
@@ -13,6 +27,13 @@ typedef struct {
 #define MAX_CAPACITY 1000000
 #define CAPACITIES 3
 #define MAX_ITEM_LIMIT 320000 
+#define DP_TILE 8192        // ƬСfloat Լ 32KB
+#define DP_ITEM_BLOCK 8     // ÿɨƬʱƷ
+#define DP_MEMORY_BUDGET (512LL * 1024 * 1024)  // ؽʹõڴޣֽڣ
+#define PARETO_EPS 1e-9     // Pareto ֦ݲ
+#define CHECKPOINT_DEMO_N 1000        // ʾԪƷ
+#define CHECKPOINT_DEMO_SCALE 1000    // ʾԪŴ
+#define CHECKPOINT_DEMO_BUDGET (16LL * 1024 * 1024)  // ʾԪڴԤ㣨ֽڣ
 const int capacities[CAPACITIES] = {10000, 100000, 1000000};
 
 // ȡǰʱ䣨ms
@@ -22,6 +43,40 @@ long long current_time_ms() {
     return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
 }
 
+// ȡǰʱ䣨usͳ I/O ʱ
+long long current_time_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+#ifdef KNAPSACK_TRACE
+static long long dp_cells;  // и¹ dp 
+static long long pareto_states_merged;  // Pareto 鲢״̬ÿ 16 ֽڣ dp 
+
+//  DP ÿ¸ÿ 2 д 1  float ķôֽ
+static void trace_dp_report(void) {
+    TraceRun* run = trace_current();
+    long long elapsed_us = run ? trace_now_us() - run->start_us : 0;
+    TRACE_COUNTER("cell_updates", dp_cells);
+    TRACE_COUNTER("bytes_touched", dp_cells * 3 * (long long)sizeof(float));
+    if (elapsed_us > 0) TRACE_COUNTER("cell_updates_per_sec", dp_cells * 1e6 / elapsed_us);
+    dp_cells = 0;
+}
+#define TRACE_DP_REPORT() trace_dp_report()
+
+//  Pareto 鲢״ֵ̬״̬
+static void trace_pareto_report(int peak_states) {
+    TRACE_COUNTER("pareto_states_merged", pareto_states_merged);
+    TRACE_COUNTER("pareto_peak_states", peak_states);
+    pareto_states_merged = 0;
+}
+#define TRACE_PARETO_REPORT(peak_states) trace_pareto_report(peak_states)
+#else
+#define TRACE_DP_REPORT() ((void)0)
+#define TRACE_PARETO_REPORT(peak_states) ((void)0)
+#endif
+
 // Ʒ
 void generate_items(Item* items, int n) {
     for (int i = 0; i < n; i++) {
@@ -32,13 +87,48 @@ void generate_items(Item* items, int n) {
     }
 }
 
+long long total_item_weight(Item* items, int n) {
+    long long total = 0;
+    for (int i = 0; i < n; i++) total += items[i].weight;
+    return total;
+}
+
+// ûƷСʱ DPȫװ
+float take_all(Item* items, int n, int* selected, int* total_weight) {
+    float total_value = 0.0f;
+    *total_weight = 0;
+    for (int i = 0; i < n; i++) {
+        if (selected) selected[i] = 1;
+        total_value += items[i].value;
+        *total_weight += items[i].weight;
+    }
+    return total_value;
+}
+
+// ɴﷶΧǰ i ƷȡСdp ֻɨ赽
+// dp[w] ʾ w ֵɴﷶΧĸӶ dp[reach]ǰƷȫװ£
+// չΧʱ dp[reach] ĸӣƷĸ¡
+static inline int extend_reach(float* dp, int reach, int weight, int capacity) {
+    int next = reach + weight < capacity ? reach + weight : capacity;
+    for (int w = reach + 1; w <= next; w++) dp[w] = dp[reach];
+    return next;
+}
+
 // ̬滮
 float knapsack_dp(Item* items, int n, int capacity, int* selected, int* total_weight) {
+    long long all_weight = total_item_weight(items, n);
+    if (n <= 0 || all_weight <= capacity) {
+        return take_all(items, n, selected, total_weight);
+    }
+
     float* dp = (float*)calloc(capacity + 1, sizeof(float));
     int* keep = (int*)calloc(n * (capacity + 1), sizeof(int));
 
+    int reach = 0;
     for (int i = 0; i < n; i++) {
-        for (int w = capacity; w >= items[i].weight; w--) {
+        reach = extend_reach(dp, reach, items[i].weight, capacity);
+        TRACE_ADD(dp_cells, reach >= items[i].weight ? reach - items[i].weight + 1 : 0);
+        for (int w = reach; w >= items[i].weight; w--) {
             float new_val = dp[w - items[i].weight] + items[i].value;
             if (new_val > dp[w]) {
                 dp[w] = new_val;
@@ -49,15 +139,24 @@ float knapsack_dp(Item* items, int n, int capacity, int* selected, int* total_we
 
     float max_val = dp[capacity];
 
+    // ݣʣѲСǰ i Ʒʱδɨ赽ĸӣʣµȫװ
     memset(selected, 0, sizeof(int) * n);
     int w = capacity;
+    long long prefix = all_weight;
     *total_weight = 0;
     for (int i = n - 1; i >= 0; i--) {
+        if (w >= prefix) {
+            int rest;
+            take_all(items, i + 1, selected, &rest);
+            *total_weight += rest;
+            break;
+        }
         if (keep[i * (capacity + 1) + w]) {
             selected[i] = 1;
             w -= items[i].weight;
             *total_weight += items[i].weight;
         }
+        prefix -= items[i].weight;
     }
 
     free(dp);
@@ -66,9 +165,16 @@ float knapsack_dp(Item* items, int n, int capacity, int* selected, int* total_we
 }
 
 float knapsack_dp_simple(Item* items, int n, int capacity) {
+    int all_weight;
+    if (n <= 0 || total_item_weight(items, n) <= capacity) {
+        return take_all(items, n, NULL, &all_weight);
+    }
     float* dp = (float*)calloc(capacity + 1, sizeof(float));
+    int reach = 0;
     for (int i = 0; i < n; i++) {
-        for (int w = capacity; w >= items[i].weight; w--) {
+        reach = extend_reach(dp, reach, items[i].weight, capacity);
+        TRACE_ADD(dp_cells, reach >= items[i].weight ? reach - items[i].weight + 1 : 0);
+        for (int w = reach; w >= items[i].weight; w--) {
             float new_val = dp[w - items[i].weight] + items[i].value;
             if (new_val > dp[w]) {
                 dp[w] = new_val;
@@ -80,6 +186,552 @@ float knapsack_dp_simple(Item* items, int n, int capacity) {
     return max_val;
 }
 
+// ֿ鶯̬滮һδ DP_ITEM_BLOCK ƷƬǰɨ
+//  s ʱڵ k Ʒ tiles-1-(s-k) Ƭȵ k-1 ƷͺһƬ
+// Ʒ k µ t ƬʱҪ w - weightڵ t Ƭ t-1 ƬʱƷ k-1
+// ѴƬƷ k δ t-1 ƬϵƷɨһ¡
+// Ծֻ DP_ITEM_BLOCK+1 Ƭɳפ棬ÿƬÿƷֻڴһΡ
+// ÿƷֻͬɨ赽ԼĿɴﷶΧĸڴڷƬʱ롣
+float knapsack_dp_blocked(Item* items, int n, int capacity) {
+    int all_weight;
+    if (n <= 0 || total_item_weight(items, n) <= capacity) {
+        return take_all(items, n, NULL, &all_weight);
+    }
+    float* dp = (float*)calloc(capacity + 1, sizeof(float));
+    int tile = DP_TILE;
+    for (int i = 0; i < n; i++) {
+        if (items[i].weight > tile) tile = items[i].weight;  // ֻ֤һƬ
+    }
+    int tiles = capacity / tile + 1;
+    int reach[DP_ITEM_BLOCK + 1];  // reach[k] Ϊڵ k Ʒ֮ǰĿɴﷶΧ
+    reach[0] = 0;
+
+    for (int b = 0; b < n; b += DP_ITEM_BLOCK) {
+        int block = n - b < DP_ITEM_BLOCK ? n - b : DP_ITEM_BLOCK;
+        for (int k = 0; k < block; k++) {
+            reach[k + 1] = reach[k] + items[b + k].weight < capacity ? reach[k] + items[b + k].weight : capacity;
+        }
+        for (int s = 0; s < tiles + block - 1; s++) {
+            for (int k = 0; k < block && k <= s; k++) {
+                int t = tiles - 1 - (s - k);
+                if (t < 0) continue;
+                int weight = items[b + k].weight;
+                float value = items[b + k].value;
+                int hi = (t + 1) * tile - 1 < reach[k + 1] ? (t + 1) * tile - 1 : reach[k + 1];
+                int lo = t * tile > weight ? t * tile : weight;
+                // dp[reach[k]] ڱƬһƬʱǵ k-1 Ʒֵ֮
+                for (int x = t * tile > reach[k] ? t * tile : reach[k] + 1; x <= hi; x++) {
+                    dp[x] = dp[reach[k]];
+                }
+                TRACE_ADD(dp_cells, hi >= lo ? hi - lo + 1 : 0);
+                // ޷֧д¶ dp[w - weight] Ǿֵ
+                float* dst = dp + lo;
+                const float* src = dp + lo - weight;
+                for (int x = hi - lo; x >= 0; x--) {
+                    float new_val = src[x] + value;
+                    dst[x] = new_val > dst[x] ? new_val : dst[x];
+                }
+            }
+        }
+        reach[0] = reach[block];
+    }
+
+    float max_val = dp[capacity];
+    free(dp);
+    return max_val;
+}
+
+// ֵܶȽȽϺ
+int compare(const void* a, const void* b) {
+    float r1 = ((Item*)a)->ratio;
+    float r2 = ((Item*)b)->ratio;
+    return (r1 < r2) - (r1 > r2);
+}
+
+// ̰ĽļֵΪ Pareto ֦õ½磨 ParetoState һ double ۼƣ
+double greedy_incumbent(Item* items, int n, int capacity) {
+    Item* sorted = (Item*)malloc(n * sizeof(Item));
+    if (sorted == NULL) {
+        perror("ڴʧ");
+        exit(1);
+    }
+    memcpy(sorted, items, n * sizeof(Item));
+    qsort(sorted, n, sizeof(Item), compare);
+    double value = 0.0;
+    int remain = capacity;
+    for (int i = 0; i < n; i++) {
+        if (sorted[i].weight <= remain) {
+            remain -= sorted[i].weight;
+            value += sorted[i].value;
+        }
+    }
+    free(sorted);
+    return value;
+}
+
+// Pareto ״ֵ̬ϸκ״̬֧
+typedef struct {
+    int weight;
+    double value;  //  double ۼӣfloat ڴֵܼ»ƫߣ֧ж֦
+} ParetoState;
+
+// ϡ Pareto NemhauserCUllmannֻ֧ (, ֵ) ״̬
+// ÿƷԭ롰ԭ + ƷԹ鲢ȥ֧״̬
+// ʱڴ״̬incumbent > 0 ʱΪĳнʵֵ
+// ֵ + ʣƷϽϸ incumbent ״ֱ̬Ӷﵽ incumbent ·Ͻ
+//  incumbentܻᱣ˽Ҵ״̬еֵ
+// ƷֵܶȽʣƷϽ LP ɳڣܶװ룬һ
+// ǰ׺Ͷֲңÿ״̬ O(log n)
+float knapsack_pareto(Item* items, int n, int capacity, double incumbent, int* peak_states) {
+    Item* sorted = (Item*)malloc(n * sizeof(Item));
+    memcpy(sorted, items, n * sizeof(Item));
+    qsort(sorted, n, sizeof(Item), compare);
+    items = sorted;
+
+    // prefix_weight[i] / prefix_value[i]ǰ i Ʒֵܼ
+    long long* prefix_weight = (long long*)malloc((n + 1) * sizeof(long long));
+    double* prefix_value = (double*)malloc((n + 1) * sizeof(double));
+    prefix_weight[0] = 0;
+    prefix_value[0] = 0.0;
+    for (int i = 0; i < n; i++) {
+        prefix_weight[i + 1] = prefix_weight[i] + items[i].weight;
+        prefix_value[i + 1] = prefix_value[i] + items[i].value;
+    }
+
+    double margin = incumbent * PARETO_EPS;  // Ͻ incumbent  double 
+    int size = 1, limit = 1024;
+    ParetoState* cur = (ParetoState*)malloc(limit * sizeof(ParetoState));
+    ParetoState* next = (ParetoState*)malloc(limit * sizeof(ParetoState));
+    if (prefix_weight == NULL || prefix_value == NULL || cur == NULL || next == NULL) {
+        perror("Pareto ڴʧ");
+        exit(1);
+    }
+    cur[0].weight = 0;
+    cur[0].value = 0.0;
+    *peak_states = 1;
+
+    for (int i = 0; i < n; i++) {
+        int weight = items[i].weight;
+        float value = items[i].value;
+        if (2 * size > limit) {
+            limit = 2 * size;
+            ParetoState* grown_cur = (ParetoState*)realloc(cur, limit * sizeof(ParetoState));
+            ParetoState* grown_next = (ParetoState*)realloc(next, limit * sizeof(ParetoState));
+            if (grown_cur == NULL || grown_next == NULL) {
+                perror("Pareto ڴʧ");
+                exit(1);
+            }
+            cur = grown_cur;
+            next = grown_next;
+        }
+
+        // 鲢 cur  cur + Ʒ iͬʱֵȣֵ״̬֧
+        int a = 0, b = 0, m = 0;
+        double last = -1.0;
+        while (a < size || (b < size && cur[b].weight + weight <= capacity)) {
+            ParetoState s;
+            int take_b = b < size && cur[b].weight + weight <= capacity &&
+                         (a >= size || cur[b].weight + weight < cur[a].weight ||
+                          (cur[b].weight + weight == cur[a].weight && cur[b].value + value > cur[a].value));
+            if (take_b) {
+                s.weight = cur[b].weight + weight;
+                s.value = cur[b].value + value;
+                b++;
+            } else {
+                s = cur[a++];
+            }
+            if (s.value <= last) continue;
+            last = s.value;
+            if (incumbent > 0) {
+                // ӵ i+1 Ʒװλ jټӵ j ı
+                long long limit_weight = prefix_weight[i + 1] + (capacity - s.weight);
+                int lo = i + 1, hi = n;
+                while (lo < hi) {
+                    int mid = (lo + hi + 1) / 2;
+                    if (prefix_weight[mid] <= limit_weight) lo = mid;
+                    else hi = mid - 1;
+                }
+                double ub = s.value + prefix_value[lo] - prefix_value[i + 1];
+                if (lo < n) ub += (double)items[lo].value * (limit_weight - prefix_weight[lo]) / items[lo].weight;
+                if (ub < incumbent - margin) continue;
+            }
+            next[m++] = s;
+        }
+        TRACE_ADD(pareto_states_merged, a + b);
+
+        ParetoState* t = cur;
+        cur = next;
+        next = t;
+        size = m;
+        if (size > *peak_states) *peak_states = size;
+        if (size == 0) break;
+    }
+
+    double best = size > 0 ? cur[size - 1].value : 0.0;
+    if (incumbent > best) best = incumbent;  // ϲᷢincumbent ǿн
+    float max_val = (float)best;
+    free(sorted);
+    free(prefix_weight);
+    free(prefix_value);
+    free(cur);
+    free(next);
+    return max_val;
+}
+
+// ӼжƷֵͬһ c ʱŽǲɴֵΪ c 
+// ظñǵȱʵʱ 0
+double subset_sum_ratio(Item* items, int n) {
+    if (n <= 0 || items[0].value <= 0) return 0;
+    double c = (double)items[0].value / items[0].weight;
+    for (int i = 1; i < n; i++) {
+        double expected = c * items[i].weight;
+        if (fabs(items[i].value - expected) > 1e-6 * expected) return 0;
+    }
+    return c;
+}
+
+// λ j ֵ reach |= reach << (q*64 + r)µλǵ firstΪ NULL
+static inline void bitset_shift_or_word(uint64_t* reach, int* first, int j, int q, int r,
+                                        uint64_t mask, int item) {
+    uint64_t hi = reach[j - q];
+    uint64_t lo = j - q > 0 ? reach[j - q - 1] : 0;
+    uint64_t added = (r ? (hi << r) | (lo >> (64 - r)) : hi) & mask & ~reach[j];
+    reach[j] |= added;
+    if (first == NULL) return;
+    while (added) {
+        first[j * 64 + __builtin_ctzll(added)] = item;
+        added &= added - 1;
+    }
+}
+
+// λɨ裺ÿƷһ reach |= reach << weight64 λһ֣AVX2  4 һ飩
+//  (capacity+1) λĿɴＯϣfirst ǿʱ first[x] ¼״ε x Ʒ
+static uint64_t* subset_sum_reach(Item* items, int n, int capacity, int* first) {
+    int words = capacity / 64 + 1;
+    int tail = (capacity + 1) % 64;
+    uint64_t top_mask = tail ? ((uint64_t)1 << tail) - 1 : ~(uint64_t)0;
+    uint64_t* reach = (uint64_t*)calloc(words, sizeof(uint64_t));
+    if (reach == NULL) {
+        perror("λڴʧ");
+        exit(1);
+    }
+    reach[0] = 1;
+    if (first != NULL) first[0] = -1;
+    int live = 0;  // ǰ i ƷȡСߵֱȻΪ 0ɨ
+
+    for (int i = 0; i < n; i++) {
+        int weight = items[i].weight;
+        if (weight > capacity) continue;
+        live = live + weight < capacity ? live + weight : capacity;
+        TRACE_ADD(dp_cells, live - weight + 1);
+        int q = weight >> 6;
+        int r = weight & 63;
+
+        // Ŀ j ֻ reach[j-q]  reach[j-q-1]Ӹߵԭظ²ֽ
+        int j = live >> 6;
+        if (j < q) continue;
+        bitset_shift_or_word(reach, first, j, q, r, j == words - 1 ? top_mask : ~(uint64_t)0, i);
+        j--;
+#ifdef __AVX2__
+        // q >= 4 ʱ 4 Ŀ [j-3, j] Դֶ j-3
+        if (q >= 4) {
+            __m128i left = _mm_cvtsi32_si128(r);
+            __m128i right = _mm_cvtsi32_si128(64 - r);  // r == 0 ʱ 64 λΪ 0
+            for (; j - 3 >= q + 1; j -= 4) {
+                __m256i hi = _mm256_loadu_si256((const __m256i*)(reach + j - 3 - q));
+                __m256i lo = _mm256_loadu_si256((const __m256i*)(reach + j - 4 - q));
+                __m256i old = _mm256_loadu_si256((const __m256i*)(reach + j - 3));
+                __m256i shifted = _mm256_or_si256(_mm256_sll_epi64(hi, left), _mm256_srl_epi64(lo, right));
+                __m256i added = _mm256_andnot_si256(old, shifted);
+                if (_mm256_testz_si256(added, added)) continue;
+                _mm256_storeu_si256((__m256i*)(reach + j - 3), _mm256_or_si256(old, shifted));
+                if (first == NULL) continue;
+                uint64_t lanes[4];
+                _mm256_storeu_si256((__m256i*)lanes, added);
+                for (int k = 0; k < 4; k++) {
+                    for (uint64_t bits = lanes[k]; bits; bits &= bits - 1) {
+                        first[(j - 3 + k) * 64 + __builtin_ctzll(bits)] = i;
+                    }
+                }
+            }
+        }
+#endif
+        for (; j >= q; j--) {
+            bitset_shift_or_word(reach, first, j, q, r, ~(uint64_t)0, i);
+        }
+    }
+    return reach;
+}
+
+// ɴԲѯǷƷӼǡΪ target
+int subset_sum_reachable(Item* items, int n, int target) {
+    if (target < 0) return 0;
+    uint64_t* reach = subset_sum_reach(items, n, target, NULL);
+    int reachable = (int)((reach[target >> 6] >> (target & 63)) & 1);
+    free(reach);
+    return reachable;
+}
+
+// λӼͣfirst[x] ¼״ε x Ʒx - weight Ȼ絽ݴ˻ݼؽ
+// ֻ (capacity+1) λ + һ int 飬 n*(capacity+1)  keep 
+// ز capacity ɴ
+int knapsack_subset_sum_bitset(Item* items, int n, int capacity, int* selected, int* total_weight) {
+    int words = capacity / 64 + 1;
+    int* first = (int*)malloc((capacity + 1) * sizeof(int));
+    if (first == NULL) {
+        perror("λڴʧ");
+        exit(1);
+    }
+    uint64_t* reach = subset_sum_reach(items, n, capacity, first);
+
+    // ߿ɴλ
+    int best = 0;
+    for (int j = words - 1; j >= 0; j--) {
+        if (reach[j]) {
+            best = j * 64 + 63 - __builtin_clzll(reach[j]);
+            break;
+        }
+    }
+
+    memset(selected, 0, sizeof(int) * n);
+    *total_weight = best;
+    for (int x = best; x > 0; x -= items[first[x]].weight) {
+        selected[first[x]] = 1;
+    }
+
+    free(reach);
+    free(first);
+    return best;
+}
+
+// 㷨ͳϢ
+typedef struct {
+    int k;                  // ÿ k Ʒһ dp
+    int checkpoints;        // 
+    int spilled;            // Ƿӳļ
+    long long io_us;        // д/ȡʱ
+    long long forward_us;   // ֵʱ
+    long long recompute_us; // ֶʱ
+} CheckpointStats;
+
+// 洢ڴŵ mallocӳ䵽ʱļڴ
+// ʱļ TMPDIRWindows Ϊ GetTempPathָĿ¼Ĭ /var/tmp
+// Ϊ /tmp  tmpfsȻռڴ
+typedef struct {
+    float* rows;
+    size_t bytes;
+    int spilled;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+} CheckpointStore;
+
+static int checkpoint_store_open(CheckpointStore* store, size_t bytes, int in_memory) {
+    store->bytes = bytes;
+    store->spilled = !in_memory;
+    store->rows = NULL;
+    if (in_memory) {
+        store->rows = (float*)malloc(bytes);
+        return store->rows != NULL;
+    }
+#ifdef _WIN32
+    char dir[MAX_PATH], path[MAX_PATH];
+    if (GetTempPathA(MAX_PATH, dir) == 0 || GetTempFileNameA(dir, "ckp", 0, path) == 0) return 0;
+    store->file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+    if (store->file == INVALID_HANDLE_VALUE) return 0;
+    store->mapping = CreateFileMappingA(store->file, NULL, PAGE_READWRITE,
+                                        (DWORD)((unsigned long long)bytes >> 32), (DWORD)bytes, NULL);
+    if (store->mapping == NULL) {
+        CloseHandle(store->file);
+        return 0;
+    }
+    store->rows = (float*)MapViewOfFile(store->mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+    if (store->rows == NULL) {
+        CloseHandle(store->mapping);
+        CloseHandle(store->file);
+        return 0;
+    }
+    return 1;
+#else
+    const char* dir = getenv("TMPDIR");
+    if (dir == NULL || dir[0] == '\0') dir = "/var/tmp";
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/knapsack_ckpt_XXXXXX", dir);
+    int fd = mkstemp(path);
+    if (fd < 0) return 0;
+    unlink(path);
+    if (ftruncate(fd, (off_t)bytes) != 0) {
+        close(fd);
+        return 0;
+    }
+    void* map = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return 0;
+    store->rows = (float*)map;
+    return 1;
+#endif
+}
+
+// ÿռ row_bytes Ĳλֻдǰ used_bytesɴﷶΧڵĲ֣
+static void checkpoint_store_put(CheckpointStore* store, int index, const float* row, size_t row_bytes,
+                                 size_t used_bytes) {
+    memcpy((char*)store->rows + (size_t)index * row_bytes, row, used_bytes);
+}
+
+static void checkpoint_store_get(CheckpointStore* store, int index, float* row, size_t row_bytes,
+                                 size_t used_bytes) {
+    memcpy(row, (char*)store->rows + (size_t)index * row_bytes, used_bytes);
+}
+
+static void checkpoint_store_close(CheckpointStore* store) {
+    if (!store->spilled) {
+        free(store->rows);
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(store->rows);
+    CloseHandle(store->mapping);
+    CloseHandle(store->file);
+#else
+    munmap(store->rows, store->bytes);
+#endif
+}
+
+// 㶯̬滮ڴԤؽѡ񷽰
+// ֵʱÿ k Ʒһ dpһε keep λʱֱӼ¼
+// δӼε keep λݡܼͨ DP  2 
+// k >= n ʱֻһΣͨ DP ͬڴΪ  + k λ + 1  dp
+float knapsack_dp_checkpoint(Item* items, int n, int capacity, int* selected, int* total_weight,
+                             long long memory_budget, CheckpointStats* stats) {
+    long long all_weight = total_item_weight(items, n);
+    memset(stats, 0, sizeof(CheckpointStats));
+    if (n <= 0 || all_weight <= capacity) {
+        return take_all(items, n, selected, total_weight);
+    }
+
+    size_t cols = (size_t)capacity + 1;
+    size_t row_bytes = cols * sizeof(float);
+    size_t keep_row_bytes = (cols + 7) / 8;
+
+    // һԤֶ keep λ dp 
+    long long keep_budget = memory_budget / 2 - (long long)row_bytes;
+    int k = keep_budget > 0 ? (int)(keep_budget / (long long)keep_row_bytes) : 1;
+    if (k < 1) k = 1;
+    if (k > n) k = n;
+    int checkpoints = (n + k - 1) / k;
+    int last_start = (checkpoints - 1) * k;  // һβҪ
+    size_t ckpt_bytes = (size_t)(checkpoints - 1) * row_bytes;
+    size_t keep_bytes = (size_t)k * keep_row_bytes;
+    int in_memory = (long long)(ckpt_bytes + keep_bytes + row_bytes) <= memory_budget;
+
+    stats->k = k;
+    stats->checkpoints = checkpoints - 1;
+    stats->spilled = checkpoints > 1 && !in_memory;
+
+    float* dp = (float*)calloc(cols, sizeof(float));
+    unsigned char* keep = (unsigned char*)malloc(keep_bytes);
+    int* ckpt_reach = (int*)malloc(checkpoints * sizeof(int));  // 㴦ĿɴﷶΧ
+    CheckpointStore store;
+    if (dp == NULL || keep == NULL || ckpt_reach == NULL ||
+        (checkpoints > 1 && !checkpoint_store_open(&store, ckpt_bytes, in_memory))) {
+        perror("ڴʧ");
+        exit(1);
+    }
+
+    // ֻ dp УһÿοͷѿɴﷶΧڵĲд
+    long long t0 = current_time_us();
+    int reach = 0;
+    memset(keep, 0, (size_t)(n - last_start) * keep_row_bytes);
+    for (int i = 0; i < n; i++) {
+        if (i % k == 0 && i < last_start) {
+            long long io_start = current_time_us();
+            ckpt_reach[i / k] = reach;
+            checkpoint_store_put(&store, i / k, dp, row_bytes, (reach + 1) * sizeof(float));
+            stats->io_us += current_time_us() - io_start;
+        }
+        reach = extend_reach(dp, reach, items[i].weight, capacity);
+        TRACE_ADD(dp_cells, reach >= items[i].weight ? reach - items[i].weight + 1 : 0);
+        if (i >= last_start) {
+            unsigned char* keep_row = keep + (size_t)(i - last_start) * keep_row_bytes;
+            for (int w = reach; w >= items[i].weight; w--) {
+                float new_val = dp[w - items[i].weight] + items[i].value;
+                if (new_val > dp[w]) {
+                    dp[w] = new_val;
+                    keep_row[w >> 3] |= (unsigned char)(1 << (w & 7));
+                }
+            }
+            continue;
+        }
+        for (int w = reach; w >= items[i].weight; w--) {
+            float new_val = dp[w - items[i].weight] + items[i].value;
+            if (new_val > dp[w]) {
+                dp[w] = new_val;
+            }
+        }
+    }
+    float max_val = dp[capacity];
+    stats->forward_us = current_time_us() - t0 - stats->io_us;
+
+    // һֱӻݣ֮ǰöε keep λٻ
+    memset(selected, 0, sizeof(int) * n);
+    int w = capacity;
+    long long prefix = all_weight;  // ǰ i Ʒ i
+    int done = 0;
+    *total_weight = 0;
+    for (int c = checkpoints - 1; c >= 0 && !done; c--) {
+        int seg_start = c * k;
+        int seg_end = seg_start + k < n ? seg_start + k : n;
+
+        long long seg_start_us = current_time_us();
+        if (c < checkpoints - 1) {
+            reach = ckpt_reach[c];
+            checkpoint_store_get(&store, c, dp, row_bytes, (reach + 1) * sizeof(float));
+            long long io_end = current_time_us();
+            stats->io_us += io_end - seg_start_us;
+            seg_start_us = io_end;
+
+            memset(keep, 0, (size_t)(seg_end - seg_start) * keep_row_bytes);
+            for (int i = seg_start; i < seg_end; i++) {
+                unsigned char* keep_row = keep + (size_t)(i - seg_start) * keep_row_bytes;
+                reach = extend_reach(dp, reach, items[i].weight, capacity);
+                TRACE_ADD(dp_cells, reach >= items[i].weight ? reach - items[i].weight + 1 : 0);
+                for (int x = reach; x >= items[i].weight; x--) {
+                    float new_val = dp[x - items[i].weight] + items[i].value;
+                    if (new_val > dp[x]) {
+                        dp[x] = new_val;
+                        keep_row[x >> 3] |= (unsigned char)(1 << (x & 7));
+                    }
+                }
+            }
+        }
+        for (int i = seg_end - 1; i >= seg_start; i--) {
+            if (w >= prefix) {
+                int rest;
+                take_all(items, i + 1, selected, &rest);
+                *total_weight += rest;
+                done = 1;
+                break;
+            }
+            unsigned char* keep_row = keep + (size_t)(i - seg_start) * keep_row_bytes;
+            if (keep_row[w >> 3] & (1 << (w & 7))) {
+                selected[i] = 1;
+                w -= items[i].weight;
+                *total_weight += items[i].weight;
+            }
+            prefix -= items[i].weight;
+        }
+        stats->recompute_us += current_time_us() - seg_start_us;
+    }
+
+    if (checkpoints > 1) checkpoint_store_close(&store);
+    free(dp);
+    free(keep);
+    free(ckpt_reach);
+    return max_val;
+}
+
 void print_excel(FILE* fp, Item* items, int n, int* selected, int total_weight, int capacity, float total_value) {
     int unselected_count = 0;
     for (int i = 0; i < n; i++) {
@@ -112,18 +764,72 @@ void print_text(FILE* fp, int n, int capacity, float total_value, long long time
     fprintf(fp, "------------------------\n\n");
 }
 
+void print_checkpoint_stats(FILE* fp, const CheckpointStats* stats) {
+    fprintf(fp, " k: %d, : %d, : %s\n",
+            stats->k, stats->checkpoints, stats->spilled ? "" : "");
+    fprintf(fp, "ʱ: %lld ms, ʱ: %lld ms, I/O ʱ: %lld ms\n",
+            stats->forward_us / 1000, stats->recompute_us / 1000, stats->io_us / 1000);
+}
+
+
+// ʾԪɨ n <= 1000 ƷԶСȫװ keep 
+// ŴýСڴԤ⣬ʹ̲ʵһ I/O ֶ
+void run_checkpoint_demo(FILE* fp_txt) {
+    int n = CHECKPOINT_DEMO_N;
+    int capacity = MAX_CAPACITY;
+    Item* items = (Item*)malloc(n * sizeof(Item));
+    int* selected = (int*)calloc(n, sizeof(int));
+    if (items == NULL || selected == NULL) {
+        perror("ڴʧ");
+        exit(1);
+    }
+    generate_items(items, n);
+    for (int i = 0; i < n; i++) {
+        items[i].weight *= CHECKPOINT_DEMO_SCALE;
+        items[i].ratio = items[i].value / items[i].weight;
+    }
+
+    int total_weight = 0;
+    CheckpointStats stats;
+    long long start = current_time_ms();
+    TRACE_RUN_BEGIN("dp_checkpoint", n, capacity);
+    TRACE_PHASE_BEGIN(solve);
+    float total_value = knapsack_dp_checkpoint(items, n, capacity, selected, &total_weight,
+                                               CHECKPOINT_DEMO_BUDGET, &stats);
+    long long end = current_time_ms();
+    TRACE_PHASE_END(solve);
+    TRACE_DP_REPORT();
+    TRACE_COUNTER("checkpoint_k", stats.k);
+    TRACE_COUNTER("checkpoint_io_us", stats.io_us);
+    TRACE_COUNTER("checkpoint_recompute_us", stats.recompute_us);
+    TRACE_PHASE_BEGIN(output);
+
+    fprintf(fp_txt, "ʾŴ %d ڴԤ %lld MB\n",
+            CHECKPOINT_DEMO_SCALE, CHECKPOINT_DEMO_BUDGET / (1024 * 1024));
+    print_checkpoint_stats(fp_txt, &stats);
+    print_text(fp_txt, n, capacity, total_value, end - start);
+    TRACE_PHASE_END(output);
+    TRACE_RUN_END();
+
+    free(items);
+    free(selected);
+}
 
-int main() {
+// ÷: dynamic_programming [n capacity]
+// ʱֻܵ (n, ) Ԫд׼ bench_runner е
+int main(int argc, char* argv[]) {
     srand(123456);
+    int only_n = argc >= 3 ? atoi(argv[1]) : 0;
+    int only_capacity = argc >= 3 ? atoi(argv[2]) : 0;
 
     int sizes[] = {1000, 2000, 3000, 4000, 5000, 6000, 7000, 8000, 9000, 10000,
                    20000, 40000, 80000, 160000, 320000};
     int sizes_count = sizeof(sizes) / sizeof(int);
 
-    FILE* fp_txt = fopen("dp_results.txt", "w");
-    FILE* fp_xls = fopen("dp_1000.xls", "w");
+    FILE* fp_txt = only_n ? stdout : fopen("dp_results.txt", "w");
+    FILE* fp_xls = only_n ? NULL : fopen("dp_1000.xls", "w");
 
-    if (!fp_txt || !fp_xls) {
+    if (!fp_txt || (!only_n && !fp_xls)) {
         printf("ļʧܣ\n");
         return 1;
     }
@@ -133,43 +839,124 @@ int main() {
         
         
         if (n > MAX_ITEM_LIMIT) {
-            printf("棺Ʒ %d  %d\n", n, MAX_ITEM_LIMIT);
+            fprintf(stderr, "棺Ʒ %d  %d\n", n, MAX_ITEM_LIMIT);
             continue;
         }
         
         Item* items = (Item*)malloc(n * sizeof(Item));
         int* selected = (int*)calloc(n, sizeof(int));
         generate_items(items, n);
+        if (only_n && n != only_n) {
+            // ԪģʽǰģƷ֤봮ɨһ
+            free(items);
+            free(selected);
+            continue;
+        }
+        long long all_weight = total_item_weight(items, n);
 
         for (int ci = 0; ci < CAPACITIES; ci++) {
             int capacity = capacities[ci];
+            if (only_capacity && capacity != only_capacity) continue;
             int total_weight = 0;
             float total_value = 0.0f;
 
             long long start = current_time_ms();
+            TRACE_RUN_BEGIN("dp", n, capacity);
+            TRACE_PHASE_BEGIN(solve);
 
-            if (n <= 1000 && (capacity == 10000 || capacity == 100000)) {
+            if (subset_sum_ratio(items, n) > 0) {
+                // ֵɹ̶λ·ͬؽѡ񣩣ֵѡƷۼ
+                knapsack_subset_sum_bitset(items, n, capacity, selected, &total_weight);
+                double sum = 0;
+                for (int i = 0; i < n; i++) {
+                    if (selected[i]) sum += items[i].value;
+                }
+                total_value = (float)sum;
+                long long end = current_time_ms();
+                TRACE_PHASE_END(solve);
+                TRACE_DP_REPORT();
+                TRACE_PHASE_BEGIN(output);
+
+                print_text(fp_txt, n, capacity, total_value, end - start);
+                if (n <= 1000 && fp_xls) {
+                    print_excel(fp_xls, items, n, selected, total_weight, capacity, total_value);
+                }
+                TRACE_PHASE_END(output);
+            } else if (n <= 1000 && (all_weight <= capacity ||
+                                     (long long)n * (capacity + 1) * sizeof(int) <= DP_MEMORY_BUDGET)) {
                 total_value = knapsack_dp(items, n, capacity, selected, &total_weight);
                 long long end = current_time_ms();
+                TRACE_PHASE_END(solve);
+                TRACE_DP_REPORT();
+                TRACE_PHASE_BEGIN(output);
                 
                 print_text(fp_txt, n, capacity, total_value, end - start);
-                print_excel(fp_xls, items, n, selected, total_weight, capacity, total_value);
+                if (fp_xls) print_excel(fp_xls, items, n, selected, total_weight, capacity, total_value);
+                TRACE_PHASE_END(output);
+            } else if (n <= 1000) {
+                //  keep ڴԤ㣬ü㷨ؽ
+                CheckpointStats stats;
+                total_value = knapsack_dp_checkpoint(items, n, capacity, selected, &total_weight,
+                                                     DP_MEMORY_BUDGET, &stats);
+                long long end = current_time_ms();
+                TRACE_PHASE_END(solve);
+                TRACE_DP_REPORT();
+                TRACE_COUNTER("checkpoint_k", stats.k);
+                TRACE_COUNTER("checkpoint_io_us", stats.io_us);
+                TRACE_COUNTER("checkpoint_recompute_us", stats.recompute_us);
+                TRACE_PHASE_BEGIN(output);
+
+                print_checkpoint_stats(fp_txt, &stats);
+                print_text(fp_txt, n, capacity, total_value, end - start);
+                if (fp_xls) print_excel(fp_xls, items, n, selected, total_weight, capacity, total_value);
+                TRACE_PHASE_END(output);
+            } else if (capacity == MAX_CAPACITY) {
+                // ³ܱ࣬ôϽ֦ϡ Pareto 
+                int peak_states = 0;
+                total_value = knapsack_pareto(items, n, capacity, greedy_incumbent(items, n, capacity), &peak_states);
+                long long end = current_time_ms();
+                TRACE_PHASE_END(solve);
+                TRACE_PARETO_REPORT(peak_states);
+                TRACE_PHASE_BEGIN(output);
+                total_weight = 0;
+                memset(selected, 0, sizeof(int) * n);
+
+                fprintf(fp_txt, "Pareto ״ֵ̬: %d\n", peak_states);
+                print_text(fp_txt, n, capacity, total_value, end - start);
+                TRACE_PHASE_END(output);
             } else {
-                total_value = knapsack_dp_simple(items, n, capacity);
+                total_value = knapsack_dp_blocked(items, n, capacity);
                 long long end = current_time_ms();
+                TRACE_PHASE_END(solve);
+                TRACE_DP_REPORT();
+                TRACE_PHASE_BEGIN(output);
                 total_weight = 0;
                 memset(selected, 0, sizeof(int) * n);
                 
                 print_text(fp_txt, n, capacity, total_value, end - start);
+                TRACE_PHASE_END(output);
             }
+            TRACE_RUN_END();
         }
 
         free(items);
         free(selected);
     }
 
+    if (only_n) {
+        // Ԫģʽ trace ļ (n, ) ⲢеԪา
+        char json_path[64], chrome_path[64];
+        snprintf(json_path, sizeof(json_path), "dp_trace_%d_%d.json", only_n, only_capacity);
+        snprintf(chrome_path, sizeof(chrome_path), "dp_chrome_trace_%d_%d.json", only_n, only_capacity);
+        TRACE_EXPORT(json_path, chrome_path);
+        return 0;
+    }
+
+    run_checkpoint_demo(fp_txt);
+
     fclose(fp_txt);
     fclose(fp_xls);
+    TRACE_EXPORT("dp_trace.json", "dp_chrome_trace.json");
     printf("̬滮ɡ\n");
     return 0;
 }
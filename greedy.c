@@ -1,8 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <windows.h>  
 #include <time.h>    
+#include <math.h>
+#include "knapsack_trace.h"
 
 typedef struct {
     int id;
@@ -17,9 +18,18 @@ const int capacities[CAPACITIES] = {10000, 100000, 1000000};
 #define ITERATIONS 10  
 
 // ȡǰʱ
-DWORD current_time_ms() {
-    return GetTickCount();  
-}
+#ifdef _WIN32
+    #include <windows.h>
+    long long current_time_ms() {
+        return GetTickCount();
+    }
+#else
+    long long current_time_ms() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+    }
+#endif
 
 // Ʒ
 void generate_items(Item* items, int n) {
@@ -40,19 +50,25 @@ int compare(const void* a, const void* b) {
 
 // ̰㷨
 float knapsack_greedy(Item* items, int n, int capacity, int* selected, int* total_weight) {
+    TRACE_PHASE_BEGIN(copy);
     Item* sorted = (Item*)malloc(n * sizeof(Item));
     if (sorted == NULL) {
         perror("ڴʧ");
         exit(1);
     }
     memcpy(sorted, items, n * sizeof(Item));
+    TRACE_PHASE_END(copy);
+
+    TRACE_PHASE_BEGIN(sort);
     qsort(sorted, n, sizeof(Item), compare);
+    TRACE_PHASE_END(sort);
 
     memset(selected, 0, n * sizeof(int));
     float total_value = 0;
     *total_weight = 0;
     int current_weight = 0;
 
+    TRACE_PHASE_BEGIN(select);
     for (int i = 0; i < n; i++) {
         int id = sorted[i].id - 1;
         if (current_weight + sorted[i].weight <= capacity) {
@@ -62,6 +78,7 @@ float knapsack_greedy(Item* items, int n, int capacity, int* selected, int* tota
             *total_weight += sorted[i].weight;
         }
     }
+    TRACE_PHASE_END(select);
 
     free(sorted);
     return total_value;
@@ -87,13 +104,287 @@ void print_text(FILE* fp, Item* items, int n, int* selected, int total_weight, i
     fprintf(fp, "------------------------\n\n");
 }
 
-int main() {
+// ---------------- ʽ̰ ----------------
+// ʽ " [ԤƷ]"֮ÿ " ֵ"Ʒ ID Ϊţ 1 ʼ
+// ֻɨһڴн磺
+//   1. ̶ȵļֱֵܶͼۼȫѶƷ/ֵԹٽֵܶ
+//   2. СѱֵǡøʣĺѡƷڶѶѸʱֱӶ
+//   3. ʱܶߵһвֵҷŵµƷֱѡ루ID д
+//      һҲѡѶ
+//   4. ܶȴӸߵöкѡʣ
+// ֱͼͬʱ LP ɳϽ磬ڱƳ̶ȡ
+#define STREAM_HEAP_LIMIT (1 << 20)  // ѡౣƷ
+#define STREAM_HIST_BINS 4096        // ֱܶͼͰ
+#define STREAM_LOG_MIN (-13.815510558) // ln(1e-6)Сɷֱܶ
+#define STREAM_LOG_MAX 13.815510558    // ln(1e6)ɷֱܶ
+#define STREAM_REFRESH 4096          // ÿٸƷ¹һֵ
+
+typedef struct {
+    long long id;
+    int weight;
+    float value;
+    float ratio;
+} StreamItem;
+
+typedef struct {
+    double weight[STREAM_HIST_BINS];
+    double value[STREAM_HIST_BINS];
+    float max_ratio[STREAM_HIST_BINS];  // Ͱܶȣ֤ϽЧ
+} RatioHistogram;
+
+typedef struct {
+    long long items_read;
+    long long items_skipped;    // ʽ
+    long long selected_count;
+    long long total_weight;
+    double total_value;
+    double upper_bound;         // LP ɳϽ
+    float threshold;            // ֵ
+    int peak_heap;
+} StreamStats;
+
+int ratio_bin(float ratio) {
+    if (!(ratio > 0)) return 0;  // дȡʽNaN ҲͰ
+    double x = (log(ratio) - STREAM_LOG_MIN) / (STREAM_LOG_MAX - STREAM_LOG_MIN) * STREAM_HIST_BINS;
+    if (!(x >= 0)) return 0;
+    if (x >= STREAM_HIST_BINS) return STREAM_HIST_BINS - 1;
+    return (int)x;
+}
+
+// ӸܶͰۼﵽ target Ͱؼֵ
+float histogram_threshold(const RatioHistogram* hist, double target) {
+    double weight = 0;
+    for (int b = STREAM_HIST_BINS - 1; b >= 0; b--) {
+        weight += hist->weight[b];
+        if (weight >= target) {
+            //  0 ͰܶΪ 0 ޵ƷΪ 0
+            if (b == 0) return 0.0f;
+            return (float)exp(STREAM_LOG_MIN + (STREAM_LOG_MAX - STREAM_LOG_MIN) * b / STREAM_HIST_BINS);
+        }
+    }
+    return 0.0f;
+}
+
+// LP ɳϽ磺ܶͰͰװ룬ٽͰͰܶװʣ
+double histogram_upper_bound(const RatioHistogram* hist, long long capacity) {
+    double remaining = (double)capacity;
+    double bound = 0;
+    for (int b = STREAM_HIST_BINS - 1; b >= 0 && remaining > 0; b--) {
+        if (hist->weight[b] <= remaining) {
+            bound += hist->value[b];
+            remaining -= hist->weight[b];
+        } else {
+            double partial = remaining * hist->max_ratio[b];
+            bound += partial < hist->value[b] ? partial : hist->value[b];
+            remaining = 0;
+        }
+    }
+    return bound;
+}
+
+void stream_heap_push(StreamItem* heap, int* size, StreamItem item) {
+    int i = (*size)++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (heap[parent].ratio <= item.ratio) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = item;
+}
+
+StreamItem stream_heap_pop(StreamItem* heap, int* size) {
+    StreamItem top = heap[0];
+    StreamItem last = heap[--(*size)];
+    int i = 0;
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= *size) break;
+        if (child + 1 < *size && heap[child + 1].ratio < heap[child].ratio) child++;
+        if (last.ratio <= heap[child].ratio) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    if (*size > 0) heap[i] = last;
+    return top;
+}
+
+int compare_stream(const void* a, const void* b) {
+    float r1 = ((StreamItem*)a)->ratio;
+    float r2 = ((StreamItem*)b)->ratio;
+    return (r1 < r2) - (r1 > r2);
+}
+
+void stream_select(FILE* out, StreamStats* stats, const StreamItem* item) {
+    fprintf(out, "%lld\n", item->id);
+    stats->selected_count++;
+    stats->total_weight += item->weight;
+    stats->total_value += item->value;
+}
+
+// ѡܶѡϸߵһ룬ʣಿмΪϷС
+void stream_flush(FILE* out, StreamStats* stats, StreamItem* heap, int* size, long long* heap_weight,
+                  long long* remaining, float threshold) {
+    qsort(heap, *size, sizeof(StreamItem), compare_stream);
+    int half = *size / 2, kept = 0;
+    for (int i = 0; i < *size; i++) {
+        if (i < half && heap[i].ratio >= threshold && heap[i].weight <= *remaining) {
+            stream_select(out, stats, &heap[i]);
+            *remaining -= heap[i].weight;
+            *heap_weight -= heap[i].weight;
+        } else {
+            heap[kept++] = heap[i];
+        }
+    }
+    for (int i = 0, j = kept - 1; i < j; i++, j--) {
+        StreamItem t = heap[i];
+        heap[i] = heap[j];
+        heap[j] = t;
+    }
+    *size = kept;
+    if (*size == STREAM_HEAP_LIMIT) {
+        *heap_weight -= stream_heap_pop(heap, size).weight;
+    }
+}
+
+// fgets ûʱʣಿ֣ 1 ʾгһ¼ƣ
+int discard_line_rest(const char* line, FILE* in) {
+    if (strchr(line, '\n') != NULL) return 0;
+    int c, dropped = 0;
+    while ((c = getc(in)) != EOF && c != '\n') dropped = 1;
+    return dropped;
+}
+
+// ʽ̰ģin ΪƷѡƷ ID д out
+int knapsack_greedy_stream(FILE* in, FILE* out, StreamStats* stats) {
+    char line[256];
+    long long capacity = 0, expected_n = 0;
+    if (fgets(line, sizeof(line), in) == NULL || discard_line_rest(line, in) || sscanf(line, "%lld %lld", &capacity, &expected_n) < 1 || capacity <= 0) {
+        fprintf(stderr, "ʽӦΪ \" [ԤƷ]\"\n");
+        return 1;
+    }
+
+    RatioHistogram* hist = (RatioHistogram*)calloc(1, sizeof(RatioHistogram));
+    StreamItem* heap = (StreamItem*)malloc(STREAM_HEAP_LIMIT * sizeof(StreamItem));
+    if (hist == NULL || heap == NULL) {
+        perror("ڴʧ");
+        exit(1);
+    }
+    memset(stats, 0, sizeof(StreamStats));
+
+    int heap_size = 0;
+    long long heap_weight = 0;
+    long long remaining = capacity;
+    float threshold = 0.0f;
+
+    while (fgets(line, sizeof(line), in) != NULL) {
+        //  strtoll long Ϊ 32 λƽ̨ Windowsϳ int Ҳʶ
+        char* weight_end;
+        char* value_end;
+        long long weight = strtoll(line, &weight_end, 10);
+        float value = strtof(weight_end, &value_end);
+        long long id = ++stats->items_read;
+        if (discard_line_rest(line, in) || weight_end == line || value_end == weight_end ||
+            weight <= 0 || weight > 2147483647LL || !isfinite(value) || value < 0) {
+            stats->items_skipped++;
+            continue;
+        }
+
+        StreamItem item = {id, (int)weight, value, value / weight};
+        int b = ratio_bin(item.ratio);
+        hist->weight[b] += item.weight;
+        hist->value[b] += item.value;
+        if (item.ratio > hist->max_ratio[b]) hist->max_ratio[b] = item.ratio;
+
+        // ԤƷ֪ʱѶĿѶǰ׺Ϊ׼
+        if (id % STREAM_REFRESH == 0) {
+            double target = (double)capacity;
+            if (expected_n > id) target = target * id / expected_n;
+            threshold = histogram_threshold(hist, target);
+        }
+
+        // ѡѸʣʱܶȲڶѶƷȻ̭
+        if (item.weight > remaining) continue;
+        if (heap_weight >= remaining && heap_size > 0 && item.ratio <= heap[0].ratio) continue;
+
+        if (heap_size == STREAM_HEAP_LIMIT) {
+            stream_flush(out, stats, heap, &heap_size, &heap_weight, &remaining, threshold);
+            if (item.weight > remaining) continue;
+        }
+        stream_heap_push(heap, &heap_size, item);
+        heap_weight += item.weight;
+
+        // ֻǡøʣĸܶȺѡ
+        while (heap_size > 0 && heap_weight - heap[0].weight >= remaining) {
+            heap_weight -= stream_heap_pop(heap, &heap_size).weight;
+        }
+        if (heap_size > stats->peak_heap) stats->peak_heap = heap_size;
+    }
+
+    // úѡѰܶȴӸߵʣ
+    qsort(heap, heap_size, sizeof(StreamItem), compare_stream);
+    for (int i = 0; i < heap_size; i++) {
+        if (heap[i].weight <= remaining) {
+            stream_select(out, stats, &heap[i]);
+            remaining -= heap[i].weight;
+        }
+    }
+
+    stats->upper_bound = histogram_upper_bound(hist, capacity);
+    stats->threshold = histogram_threshold(hist, (double)capacity);
+    free(hist);
+    free(heap);
+    return 0;
+}
+
+void print_stream_text(FILE* fp, const StreamStats* stats, double elapsed_ms) {
+    double gap = stats->upper_bound > 0 ? (stats->upper_bound - stats->total_value) / stats->upper_bound : 0.0;
+    fprintf(fp, "ʽƷ: %lld %lld У\n", stats->items_read, stats->items_skipped);
+    fprintf(fp, "ѡƷ: %lld\n", stats->selected_count);
+    fprintf(fp, "ֵܼ: %.2f\n", stats->total_value);
+    fprintf(fp, ": %lld\n", stats->total_weight);
+    fprintf(fp, "LP ɳϽ: %.2fԲ: %.4f%%\n", stats->upper_bound, gap * 100);
+    fprintf(fp, "ֵܶ: %.4fѡѷֵ: %d\n", stats->threshold, stats->peak_heap);
+    fprintf(fp, "ִʱ: %.2f ms\n", elapsed_ms);
+    fprintf(fp, "------------------------\n\n");
+}
+
+// ÷: greedy [n capacity] | greedy --stream [ļ]
+// ʱֻܵ (n, ) Ԫд׼ bench_runner еȣ
+// --stream ļ׼ʽȡƷѡ ID д greedy_stream_selected.txt
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && strcmp(argv[1], "--stream") == 0) {
+        FILE* in = argc >= 3 ? fopen(argv[2], "r") : stdin;
+        FILE* out = fopen("greedy_stream_selected.txt", "w");
+        FILE* fp_txt = fopen("greedy_stream_results.txt", "w");
+        if (in == NULL || out == NULL || fp_txt == NULL) {
+            perror("޷ļ");
+            return 1;
+        }
+        setvbuf(in, NULL, _IOFBF, 1 << 20);
+        setvbuf(out, NULL, _IOFBF, 1 << 20);
+
+        StreamStats stats;
+        long long start = current_time_ms();
+        if (knapsack_greedy_stream(in, out, &stats) != 0) return 1;
+        long long end = current_time_ms();
+
+        print_stream_text(fp_txt, &stats, (double)(end - start));
+        print_stream_text(stdout, &stats, (double)(end - start));
+        fclose(out);
+        fclose(fp_txt);
+        if (in != stdin) fclose(in);
+        return 0;
+    }
+
     srand((unsigned int)time(NULL));  // ʼ
+    int only_n = argc >= 3 ? atoi(argv[1]) : 0;
+    int only_capacity = argc >= 3 ? atoi(argv[2]) : 0;
 
     int sizes[] = {1000, 2000, 3000, 4000, 5000, 6000, 7000, 8000, 9000, 10000, 20000, 40000, 80000, 160000, 320000};
     int sizes_count = sizeof(sizes) / sizeof(int);
 
-    FILE* fp_txt = fopen("greedy_results.txt", "w");
+    FILE* fp_txt = only_n ? stdout : fopen("greedy_results.txt", "w");
     if (fp_txt == NULL) {
         perror("޷ļ");
         return 1;
@@ -101,6 +392,7 @@ int main() {
 
     for (int si = 0; si < sizes_count; si++) {
         int n = sizes[si];
+        if (only_n && n != only_n) continue;
         Item* items = (Item*)malloc(n * sizeof(Item));
         int* selected = (int*)calloc(n, sizeof(int));
         if (items == NULL || selected == NULL) {
@@ -115,32 +407,47 @@ int main() {
 
         for (int ci = 0; ci < CAPACITIES; ci++) {
             int capacity = capacities[ci];
+            if (only_capacity && capacity != only_capacity) continue;
             int total_weight = 0;
-            DWORD total_elapsed_ms = 0;
+            long long total_elapsed_ms = 0;
 
             // εȡƽټʱ
             for (int iter = 0; iter < ITERATIONS; iter++) {
                 memset(selected, 0, n * sizeof(int));  
 
-                DWORD start = current_time_ms();
+                long long start = current_time_ms();
                 float total_value = knapsack_greedy(items, n, capacity, selected, &total_weight);
-                DWORD end = current_time_ms();
+                long long end = current_time_ms();
 
                 total_elapsed_ms += (end - start);
             }
 
             double avg_elapsed_ms = (double)total_elapsed_ms / ITERATIONS;
            
-            print_text(fp_txt, items, n, selected, total_weight, capacity, 
-                      knapsack_greedy(items, n, capacity, selected, &total_weight), 
-                      avg_elapsed_ms);
+            // ʱѭ֮ⵥ¼һεãʹ trace еĽ׶κʱ뵥ƽɱ
+            TRACE_RUN_BEGIN("greedy", n, capacity);
+            float total_value = knapsack_greedy(items, n, capacity, selected, &total_weight);
+            TRACE_PHASE_BEGIN(output);
+            print_text(fp_txt, items, n, selected, total_weight, capacity, total_value, avg_elapsed_ms);
+            TRACE_PHASE_END(output);
+            TRACE_RUN_END();
         }
 
         free(items);
         free(selected);
     }
 
+    if (only_n) {
+        // Ԫģʽ trace ļ (n, ) ⲢеԪา
+        char json_path[64], chrome_path[64];
+        snprintf(json_path, sizeof(json_path), "greedy_trace_%d_%d.json", only_n, only_capacity);
+        snprintf(chrome_path, sizeof(chrome_path), "greedy_chrome_trace_%d_%d.json", only_n, only_capacity);
+        TRACE_EXPORT(json_path, chrome_path);
+        return 0;
+    }
+
     fclose(fp_txt);
+    TRACE_EXPORT("greedy_trace.json", "greedy_chrome_trace.json");
     printf("̰ķִɣд greedy_results.txt\n");
     return 0;
 }
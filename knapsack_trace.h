@@ -0,0 +1,215 @@
+// knapsack_trace.h
+// ʱߵʱ -DKNAPSACK_TRACE ã
+// δʱ TRACE_* չΪգκο
+//
+// ÿ (n, ) Ϊһ run
+//   TRACE_RUN_BEGIN("dp", n, capacity);
+//   TRACE_PHASE_BEGIN(sort); ... TRACE_PHASE_END(sort);
+//   TRACE_COUNTER("nodes", count);
+//   TRACE_RUN_END();
+// ʱ TRACE_EXPORT("x_trace.json", "x_chrome.json") 
+// ṹ JSON  Chrome tracechrome://tracing / Perfetto ɴ򿪣
+#ifndef KNAPSACK_TRACE_H
+#define KNAPSACK_TRACE_H
+
+#ifdef KNAPSACK_TRACE
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define TRACE_MAX_RUNS 256
+#define TRACE_MAX_FIELDS 16
+#define TRACE_MAX_EVENTS (1 << 18)
+
+typedef struct {
+    const char* name;
+    double value;
+} TraceField;
+
+typedef struct {
+    const char* solver;
+    int n;
+    int capacity;
+    long long start_us;
+    long long dur_us;
+    int counter_count;
+    TraceField counters[TRACE_MAX_FIELDS];
+    int phase_count;
+    TraceField phases[TRACE_MAX_FIELDS];  // ׶ۼƺʱus
+} TraceRun;
+
+typedef struct {
+    const char* name;
+    char ph;              // 'X' ¼'i' ˲ʱ¼
+    int run;
+    long long ts_us;
+    long long dur_us;
+    const char* arg_name;
+    double arg;
+} TraceEvent;
+
+static TraceRun trace_runs[TRACE_MAX_RUNS];
+static int trace_run_count = 0;
+static int trace_run_index = -1;   // ǰ run ±꣬run ֮򳬳ޱʱΪ -1
+static TraceEvent trace_events[TRACE_MAX_EVENTS];
+static int trace_event_count = 0;
+static long long trace_dropped = 0;
+static long long trace_origin_us = -1;
+
+static inline long long trace_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    long long now = (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    if (trace_origin_us < 0) trace_origin_us = now;
+    return now - trace_origin_us;
+}
+
+static inline TraceRun* trace_current(void) {
+    return trace_run_index >= 0 ? &trace_runs[trace_run_index] : NULL;
+}
+
+static inline void trace_push(const char* name, char ph, long long ts_us, long long dur_us,
+                              const char* arg_name, double arg) {
+    if (trace_event_count >= TRACE_MAX_EVENTS) {
+        trace_dropped++;
+        return;
+    }
+    TraceEvent* e = &trace_events[trace_event_count++];
+    e->name = name;
+    e->ph = ph;
+    e->run = trace_run_index;
+    e->ts_us = ts_us;
+    e->dur_us = dur_us;
+    e->arg_name = arg_name;
+    e->arg = arg;
+}
+
+static inline void trace_field_add(TraceField* fields, int* count, const char* name, double value) {
+    for (int i = 0; i < *count; i++) {
+        if (strcmp(fields[i].name, name) == 0) {
+            fields[i].value += value;
+            return;
+        }
+    }
+    if (*count < TRACE_MAX_FIELDS) {
+        fields[*count].name = name;
+        fields[*count].value = value;
+        (*count)++;
+    }
+}
+
+static inline void trace_run_begin(const char* solver, int n, int capacity) {
+    if (trace_run_count >= TRACE_MAX_RUNS) {
+        trace_dropped++;
+        trace_run_index = -1;
+        return;
+    }
+    trace_run_index = trace_run_count++;
+    TraceRun* run = &trace_runs[trace_run_index];
+    memset(run, 0, sizeof(TraceRun));
+    run->solver = solver;
+    run->n = n;
+    run->capacity = capacity;
+    run->start_us = trace_now_us();
+}
+
+static inline void trace_run_end(void) {
+    TraceRun* run = trace_current();
+    if (run == NULL) return;
+    run->dur_us = trace_now_us() - run->start_us;
+    trace_push(run->solver, 'X', run->start_us, run->dur_us, NULL, 0);
+    trace_run_index = -1;
+}
+
+static inline void trace_counter(const char* name, double value) {
+    TraceRun* run = trace_current();
+    if (run != NULL) trace_field_add(run->counters, &run->counter_count, name, value);
+}
+
+// run ֮Ľ׶Σ̰ĵļʱѭ¼޹¼
+static inline void trace_phase_end(const char* name, long long start_us) {
+    TraceRun* run = trace_current();
+    if (run == NULL) return;
+    long long now = trace_now_us();
+    trace_field_add(run->phases, &run->phase_count, name, (double)(now - start_us));
+    trace_push(name, 'X', start_us, now - start_us, NULL, 0);
+}
+
+static inline void trace_instant(const char* name, const char* arg_name, double arg) {
+    trace_push(name, 'i', trace_now_us(), 0, arg_name, arg);
+}
+
+static inline void trace_write_fields(FILE* fp, const TraceField* fields, int count) {
+    fprintf(fp, "{");
+    for (int i = 0; i < count; i++) {
+        fprintf(fp, "%s\"%s\": %.17g", i ? ", " : "", fields[i].name, fields[i].value);
+    }
+    fprintf(fp, "}");
+}
+
+static inline void trace_export(const char* json_path, const char* chrome_path) {
+    FILE* fp = fopen(json_path, "w");
+    if (fp != NULL) {
+        fprintf(fp, "{\"dropped_events\": %lld, \"runs\": [\n", trace_dropped);
+        for (int r = 0; r < trace_run_count; r++) {
+            TraceRun* run = &trace_runs[r];
+            fprintf(fp, "  {\"solver\": \"%s\", \"n\": %d, \"capacity\": %d, \"wall_us\": %lld, \"counters\": ",
+                    run->solver, run->n, run->capacity, run->dur_us);
+            trace_write_fields(fp, run->counters, run->counter_count);
+            fprintf(fp, ", \"phases_us\": ");
+            trace_write_fields(fp, run->phases, run->phase_count);
+            fprintf(fp, "}%s\n", r + 1 < trace_run_count ? "," : "");
+        }
+        fprintf(fp, "]}\n");
+        fclose(fp);
+    }
+
+    fp = fopen(chrome_path, "w");
+    if (fp != NULL) {
+        fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+        for (int i = 0; i < trace_event_count; i++) {
+            TraceEvent* e = &trace_events[i];
+            TraceRun* run = e->run >= 0 ? &trace_runs[e->run] : NULL;
+            fprintf(fp, "  {\"name\": \"%s\", \"ph\": \"%c\", \"pid\": 1, \"tid\": %d, \"ts\": %lld",
+                    e->name, e->ph, e->run + 1, e->ts_us);
+            if (e->ph == 'X') {
+                fprintf(fp, ", \"dur\": %lld", e->dur_us);
+            } else {
+                fprintf(fp, ", \"s\": \"t\"");
+            }
+            fprintf(fp, ", \"args\": {");
+            if (run != NULL) fprintf(fp, "\"n\": %d, \"capacity\": %d", run->n, run->capacity);
+            if (e->arg_name != NULL) fprintf(fp, "%s\"%s\": %.17g", run ? ", " : "", e->arg_name, e->arg);
+            fprintf(fp, "}}%s\n", i + 1 < trace_event_count ? "," : "");
+        }
+        fprintf(fp, "]}\n");
+        fclose(fp);
+    }
+}
+
+#define TRACE_INC(counter) ((counter)++)
+#define TRACE_ADD(counter, x) ((counter) += (x))
+#define TRACE_RUN_BEGIN(solver, n, capacity) trace_run_begin(solver, n, capacity)
+#define TRACE_RUN_END() trace_run_end()
+#define TRACE_COUNTER(name, value) trace_counter(name, (double)(value))
+#define TRACE_PHASE_BEGIN(phase) long long trace_phase_##phase = trace_now_us()
+#define TRACE_PHASE_END(phase) trace_phase_end(#phase, trace_phase_##phase)
+#define TRACE_INSTANT(name, arg_name, arg) trace_instant(name, arg_name, (double)(arg))
+#define TRACE_EXPORT(json_path, chrome_path) trace_export(json_path, chrome_path)
+
+#else
+
+#define TRACE_INC(counter) ((void)0)
+#define TRACE_ADD(counter, x) ((void)0)
+#define TRACE_RUN_BEGIN(solver, n, capacity) ((void)0)
+#define TRACE_RUN_END() ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_PHASE_BEGIN(phase) ((void)0)
+#define TRACE_PHASE_END(phase) ((void)0)
+#define TRACE_INSTANT(name, arg_name, arg) ((void)0)
+#define TRACE_EXPORT(json_path, chrome_path) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,670 @@
+// solver.c
+// ͳһ solve() nΧֵ-Թ㷨ʱ
+// Զѡ ۰ö / ֧޽ /  DP /  DP / ̰+Ͻ һ
+// װһ `solver --calibrate`ڱ΢׼д solver_calibration.txt
+// ֮ solve() ȡļΪģͣļʱʹĬֵ
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+typedef struct {
+    int id;
+    int weight;
+    float value;
+    float ratio;
+} Item;
+
+#define CAPACITIES 3
+const int capacities[CAPACITIES] = {10000, 100000, 1000000};
+
+#define MITM_MAX_N 40                            // ۰öٵƷ
+#define CORE_HALF 50                             //  DP ڶϵȡƷ
+#define SOLVE_MEMORY_BUDGET (512LL * 1024 * 1024) // DP keep λڴޣֽڣ
+#define BNB_CORR_PENALTY 20.0                    // ԶԷ֧޽ڵָͷ
+#define BNB_ABORT_FACTOR 50.0                    // ʵʽڵֵñ
+#define CALIBRATION_FILE "solver_calibration.txt"
+
+typedef enum {
+    SOLVER_GREEDY,
+    SOLVER_MITM,
+    SOLVER_BNB,
+    SOLVER_DP,
+    SOLVER_CORE_DP
+} SolverKind;
+
+const char* solver_names[] = {"greedy+bound", "mitm", "branch&bound", "dp", "core-dp"};
+
+// ģͣ㷨ĺʱns
+typedef struct {
+    double sort_ns;         // ÿ n*log2(n)
+    double mitm_ns;         // ۰ö٣ÿ 2^(n/2)*(n/2)
+    double bnb_node_ns;     // ֧޽磬ÿڵ
+    double dp_cell_ns;      // DPÿ
+} CostModel;
+
+// ʵ
+typedef struct {
+    int n;
+    int capacity;
+    long long total_weight;
+    int min_weight;
+    int max_weight;
+    double correlation;     // ֵƤѷϵ
+} Features;
+
+// ֵϽһ double ۼƣfloat ۼڼǧֵܼ»ƫߣܳʵֵϽ
+typedef struct {
+    SolverKind kind;
+    double estimated_ms;
+    double value;           // ѡƷֵܼ
+    double upper_bound;     // LP ɳϽ
+    double gap;             // (Ͻ - ) / Ͻ
+    int fallback;           // ѡ㷨㷨
+} SolveReport;
+
+static CostModel cost_model = {12.0, 3.0, 40.0, 0.6};
+static int cost_model_loaded = 0;
+
+// ȡǰʱ
+long long current_time_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+long long current_time_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// Ʒ
+void generate_items(Item* items, int n) {
+    for (int i = 0; i < n; i++) {
+        items[i].id = i + 1;
+        items[i].weight = rand() % 100 + 1;
+        items[i].value = (float)(rand() % 901 + 100) + (rand() % 100) / 100.0f;
+        items[i].ratio = items[i].value / items[i].weight;
+    }
+}
+
+// ֵܶȽȽϺ
+int compare(const void* a, const void* b) {
+    float r1 = ((Item*)a)->ratio;
+    float r2 = ((Item*)b)->ratio;
+    return (r1 < r2) - (r1 > r2);
+}
+
+void compute_features(Item* items, int n, int capacity, Features* f) {
+    double sw = 0, sv = 0, sww = 0, svv = 0, swv = 0;
+    f->n = n;
+    f->capacity = capacity;
+    f->total_weight = 0;
+    f->min_weight = n > 0 ? items[0].weight : 0;
+    f->max_weight = 0;
+    for (int i = 0; i < n; i++) {
+        double w = items[i].weight, v = items[i].value;
+        f->total_weight += items[i].weight;
+        if (items[i].weight < f->min_weight) f->min_weight = items[i].weight;
+        if (items[i].weight > f->max_weight) f->max_weight = items[i].weight;
+        sw += w; sv += v; sww += w * w; svv += v * v; swv += w * v;
+    }
+    double cov = swv - sw * sv / n;
+    double var_w = sww - sw * sw / n;
+    double var_v = svv - sv * sv / n;
+    f->correlation = var_w > 0 && var_v > 0 ? cov / sqrt(var_w * var_v) : 1.0;
+}
+
+// ѰֵܶƷ̰װ룬ͬʱ DantzigLP ɳڣϽ
+double greedy_with_bound(Item* sorted, int n, int capacity, int* take, double* upper_bound) {
+    int remain = capacity;
+    double value = 0;
+    double bound = 0;
+    int bound_open = 1;
+    for (int i = 0; i < n; i++) {
+        take[i] = 0;
+        if (sorted[i].weight <= remain) {
+            take[i] = 1;
+            remain -= sorted[i].weight;
+            value += sorted[i].value;
+            if (bound_open) bound += sorted[i].value;
+        } else if (bound_open) {
+            bound += (double)sorted[i].value * remain / sorted[i].weight;
+            bound_open = 0;
+        }
+    }
+    *upper_bound = bound_open ? value : bound;  // ȫװʱ̰ļ
+    return value;
+}
+
+typedef struct {
+    int weight;
+    float value;
+    unsigned int mask;
+} HalfSubset;
+
+int compare_half(const void* a, const void* b) {
+    return ((HalfSubset*)a)->weight - ((HalfSubset*)b)->weight;
+}
+
+// öӼ밴ǰ׺ţǰÿӼֲѴ
+float knapsack_mitm(Item* items, int n, int capacity, int* take) {
+    int h = n / 2, m = n - h;
+    int count_a = 1 << h, count_b = 1 << m;
+    int* wa = (int*)malloc(count_a * sizeof(int));
+    float* va = (float*)malloc(count_a * sizeof(float));
+    HalfSubset* b = (HalfSubset*)malloc(count_b * sizeof(HalfSubset));
+    int* best_b = (int*)malloc(count_b * sizeof(int));
+    if (wa == NULL || va == NULL || b == NULL || best_b == NULL) {
+        perror("ڴʧ");
+        exit(1);
+    }
+
+    // 룺λӼֵ
+    b[0].weight = 0;
+    b[0].value = 0;
+    b[0].mask = 0;
+    for (int mask = 1; mask < count_b; mask++) {
+        int j = __builtin_ctz(mask);
+        b[mask].weight = b[mask & (mask - 1)].weight + items[h + j].weight;
+        b[mask].value = b[mask & (mask - 1)].value + items[h + j].value;
+        b[mask].mask = mask;
+    }
+    qsort(b, count_b, sizeof(HalfSubset), compare_half);
+    best_b[0] = 0;
+    for (int i = 1; i < count_b; i++) {
+        best_b[i] = b[i].value > b[best_b[i - 1]].value ? i : best_b[i - 1];
+    }
+
+    float best = -1;
+    unsigned int best_a_mask = 0, best_b_mask = 0;
+    wa[0] = 0;
+    va[0] = 0;
+    for (int mask = 0; mask < count_a; mask++) {
+        if (mask > 0) {
+            int j = __builtin_ctz(mask);
+            wa[mask] = wa[mask & (mask - 1)] + items[j].weight;
+            va[mask] = va[mask & (mask - 1)] + items[j].value;
+        }
+        int remain = capacity - wa[mask];
+        if (remain < 0) continue;
+        // һ <= remain ĺӼ
+        int lo = 0, hi = count_b - 1;
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (b[mid].weight <= remain) lo = mid;
+            else hi = mid - 1;
+        }
+        int k = best_b[lo];
+        if (va[mask] + b[k].value > best) {
+            best = va[mask] + b[k].value;
+            best_a_mask = mask;
+            best_b_mask = b[k].mask;
+        }
+    }
+
+    for (int i = 0; i < h; i++) take[i] = (best_a_mask >> i) & 1;
+    for (int j = 0; j < m; j++) take[h + j] = (best_b_mask >> j) & 1;
+
+    free(wa);
+    free(va);
+    free(b);
+    free(best_b);
+    return best;
+}
+
+// Ʒǰ׺ͣʹ޼Ϊ O(log n)
+typedef struct {
+    double* weight;
+    double* value;
+} Prefix;
+
+void build_prefix(Item* sorted, int n, Prefix* p) {
+    p->weight = (double*)malloc((n + 1) * sizeof(double));
+    p->value = (double*)malloc((n + 1) * sizeof(double));
+    p->weight[0] = 0;
+    p->value[0] = 0;
+    for (int i = 0; i < n; i++) {
+        p->weight[i + 1] = p->weight[i] + sorted[i].weight;
+        p->value[i + 1] = p->value[i] + sorted[i].value;
+    }
+}
+
+// ӵ level Ʒܶ˳װ룬һװµİ
+double prefix_bound(Item* sorted, int n, Prefix* p, int level, int weight, double value, int capacity) {
+    double limit = p->weight[level] + (capacity - weight);
+    int lo = level, hi = n;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (p->weight[mid] <= limit) lo = mid;
+        else hi = mid - 1;
+    }
+    double bound = value + p->value[lo] - p->value[level];
+    if (lo < n) bound += (double)sorted[lo].value * (limit - p->weight[lo]) / sorted[lo].weight;
+    return bound;
+}
+
+// ʽȷ֧޽磨ݹ飬ڴ nڵ node_limit ʱ -1
+float knapsack_bnb(Item* sorted, int n, int capacity, int* take, long long node_limit, long long* nodes) {
+    Prefix p;
+    build_prefix(sorted, n, &p);
+    int* x = (int*)calloc(n, sizeof(int));
+    double best = 0;  // ǰֵ
+    int weight = 0;
+    double value = 0;
+    int k = 0;
+    *nodes = 0;
+    memset(take, 0, n * sizeof(int));
+
+    for (;;) {
+        // ǰװװװµ޲
+        int pruned = 0;
+        while (k < n) {
+            (*nodes)++;
+            if (weight + sorted[k].weight <= capacity) {
+                x[k] = 1;
+                weight += sorted[k].weight;
+                value += sorted[k].value;
+            } else {
+                x[k] = 0;
+                if (prefix_bound(sorted, n, &p, k + 1, weight, value, capacity) <= best) {
+                    pruned = 1;
+                    break;
+                }
+            }
+            k++;
+        }
+        if (!pruned && value > best) {
+            best = value;
+            memcpy(take, x, n * sizeof(int));
+        }
+        if (*nodes > node_limit) {
+            best = -1;
+            break;
+        }
+
+        // ݣһװƷΪװֱ
+        int resumed = 0;
+        for (k = k < n ? k : n - 1; k >= 0; k--) {
+            if (!x[k]) continue;
+            x[k] = 0;
+            weight -= sorted[k].weight;
+            value -= sorted[k].value;
+            if (prefix_bound(sorted, n, &p, k + 1, weight, value, capacity) > best) {
+                k++;
+                resumed = 1;
+                break;
+            }
+        }
+        if (!resumed) break;
+    }
+
+    free(x);
+    free(p.weight);
+    free(p.value);
+    return (float)best;
+}
+
+//  bit ѹ keep  0-1  DPÿƷֻɨ赽ɴﷶΧǰ׺ȡС
+// ĸ dp[reach] 룻ȫװʱֱӷء
+float knapsack_dp_keep(Item* items, int n, int capacity, int* take) {
+    long long all_weight = 0;
+    float all_value = 0;
+    for (int i = 0; i < n; i++) {
+        all_weight += items[i].weight;
+        all_value += items[i].value;
+        take[i] = 1;
+    }
+    if (n <= 0 || all_weight <= capacity) return all_value;
+
+    size_t row_bytes = ((size_t)capacity + 1 + 7) / 8;
+    float* dp = (float*)calloc(capacity + 1, sizeof(float));
+    unsigned char* keep = (unsigned char*)calloc((size_t)n * row_bytes, 1);
+    if (dp == NULL || keep == NULL) {
+        perror("ڴʧ");
+        exit(1);
+    }
+
+    int reach = 0;
+    for (int i = 0; i < n; i++) {
+        unsigned char* row = keep + (size_t)i * row_bytes;
+        int next = reach + items[i].weight < capacity ? reach + items[i].weight : capacity;
+        for (int w = reach + 1; w <= next; w++) dp[w] = dp[reach];
+        reach = next;
+        for (int w = reach; w >= items[i].weight; w--) {
+            float new_val = dp[w - items[i].weight] + items[i].value;
+            if (new_val > dp[w]) {
+                dp[w] = new_val;
+                row[w >> 3] |= (unsigned char)(1 << (w & 7));
+            }
+        }
+    }
+
+    // ݣʣСǰ i Ʒʱʣµȫװ루take  1
+    float max_val = dp[capacity];
+    int w = capacity;
+    long long prefix = all_weight;
+    for (int i = n - 1; i >= 0 && w < prefix; i--) {
+        take[i] = (keep[(size_t)i * row_bytes + (w >> 3)] >> (w & 7)) & 1;
+        if (take[i]) w -= items[i].weight;
+        prefix -= items[i].weight;
+    }
+
+    free(dp);
+    free(keep);
+    return max_val;
+}
+
+//  DPϵ֮ǰƷȫװ֮ȲװֻԶϵ CORE_HALF Ʒ DP
+// ʣٰ̰ܶĲ롣֤ţ LP Ͻ
+float knapsack_core_dp(Item* sorted, int n, int capacity, int* take) {
+    int b = 0, used = 0;
+    while (b < n && used + sorted[b].weight <= capacity) {
+        used += sorted[b].weight;
+        b++;
+    }
+    int lo = b - CORE_HALF > 0 ? b - CORE_HALF : 0;
+    int hi = b + CORE_HALF < n ? b + CORE_HALF : n;
+
+    float value = 0;
+    int weight = 0;
+    for (int i = 0; i < lo; i++) {
+        take[i] = 1;
+        value += sorted[i].value;
+        weight += sorted[i].weight;
+    }
+    int residual = capacity - weight;
+    long long core_weight = 0;
+    for (int i = lo; i < hi; i++) core_weight += sorted[i].weight;
+    int core_capacity = core_weight < residual ? (int)core_weight : residual;
+
+    value += knapsack_dp_keep(sorted + lo, hi - lo, core_capacity, take + lo);
+    for (int i = lo; i < hi; i++) {
+        if (take[i]) weight += sorted[i].weight;
+    }
+    for (int i = hi; i < n; i++) {
+        take[i] = weight + sorted[i].weight <= capacity;
+        if (take[i]) {
+            weight += sorted[i].weight;
+            value += sorted[i].value;
+        }
+    }
+    return value;
+}
+
+void save_cost_model(const CostModel* model, const char* path) {
+    FILE* fp = fopen(path, "w");
+    if (fp == NULL) {
+        perror("޷д궨ļ");
+        return;
+    }
+    fprintf(fp, "sort_ns %.6f\n", model->sort_ns);
+    fprintf(fp, "mitm_ns %.6f\n", model->mitm_ns);
+    fprintf(fp, "bnb_node_ns %.6f\n", model->bnb_node_ns);
+    fprintf(fp, "dp_cell_ns %.6f\n", model->dp_cell_ns);
+    fclose(fp);
+}
+
+int load_cost_model(CostModel* model, const char* path) {
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL) return 0;
+    char key[64];
+    double val;
+    while (fscanf(fp, "%63s %lf", key, &val) == 2) {
+        if (strcmp(key, "sort_ns") == 0) model->sort_ns = val;
+        else if (strcmp(key, "mitm_ns") == 0) model->mitm_ns = val;
+        else if (strcmp(key, "bnb_node_ns") == 0) model->bnb_node_ns = val;
+        else if (strcmp(key, "dp_cell_ns") == 0) model->dp_cell_ns = val;
+    }
+    fclose(fp);
+    return 1;
+}
+
+// ΢׼ÿ㷨һеȹģʵλʱ
+void calibrate_cost_model(CostModel* model) {
+    srand(20240601);
+    int n = 200000;
+    Item* items = (Item*)malloc(n * sizeof(Item));
+    int* take = (int*)malloc(n * sizeof(int));
+    generate_items(items, n);
+
+    long long t0 = current_time_us();
+    qsort(items, n, sizeof(Item), compare);
+    model->sort_ns = (current_time_us() - t0) * 1000.0 / (n * log2((double)n));
+
+    // ɴﷶΧͳʵɨĸ
+    generate_items(items, n);
+    int dp_n = 2000, dp_capacity = 20000;
+    double cells = 0;
+    long long reach = 0;
+    for (int i = 0; i < dp_n; i++) {
+        reach = reach + items[i].weight < dp_capacity ? reach + items[i].weight : dp_capacity;
+        cells += reach - items[i].weight + 1;
+    }
+    t0 = current_time_us();
+    knapsack_dp_keep(items, dp_n, dp_capacity, take);
+    model->dp_cell_ns = (current_time_us() - t0) * 1000.0 / cells;
+
+    int mitm_n = 32;
+    t0 = current_time_us();
+    knapsack_mitm(items, mitm_n, 25 * mitm_n, take);
+    model->mitm_ns = (current_time_us() - t0) * 1000.0 / (pow(2.0, mitm_n / 2) * (mitm_n / 2));
+
+    long long nodes = 0;
+    generate_items(items, 20000);
+    qsort(items, 20000, sizeof(Item), compare);
+    t0 = current_time_us();
+    knapsack_bnb(items, 20000, 100000, take, 1LL << 40, &nodes);
+    model->bnb_node_ns = (current_time_us() - t0) * 1000.0 / (nodes > 0 ? nodes : 1);
+
+    free(items);
+    free(take);
+}
+
+// 㷨Ĺƺʱmsʱ -1
+double estimate_ms(SolverKind kind, const Features* f) {
+    double n = f->n;
+    double sort = cost_model.sort_ns * n * log2(n + 1);
+    double dp_capacity = f->total_weight < f->capacity ? f->total_weight : f->capacity;
+    switch (kind) {
+    case SOLVER_GREEDY:
+        return sort / 1e6;
+    case SOLVER_MITM:
+        if (f->n > MITM_MAX_N) return -1;
+        return cost_model.mitm_ns * pow(2.0, f->n / 2) * (f->n / 2) / 1e6;
+    case SOLVER_BNB: {
+        // ʵڵԼΪ O(n)Խǿϵ㸽Լ֦ƷԽ
+        double corr = f->correlation > 0 ? f->correlation : 0;
+        double nodes = n * exp(BNB_CORR_PENALTY * corr);
+        return (sort + cost_model.bnb_node_ns * nodes * log2(n + 1)) / 1e6;
+    }
+    case SOLVER_DP:
+        if (n * (dp_capacity + 1) / 8 > SOLVE_MEMORY_BUDGET) return -1;
+        return cost_model.dp_cell_ns * n * dp_capacity / 1e6;
+    case SOLVER_CORE_DP: {
+        double core_n = f->n < 2 * CORE_HALF ? f->n : 2 * CORE_HALF;
+        double core_capacity = core_n * f->max_weight;
+        if (core_capacity > f->capacity) core_capacity = f->capacity;
+        return (sort + cost_model.dp_cell_ns * core_n * core_capacity) / 1e6;
+    }
+    }
+    return -1;
+}
+
+typedef struct {
+    SolverKind kind;
+    double estimated_ms;    // -1 ʾ
+} Candidate;
+
+// ѡ񷽰ʵֵܼ
+double selection_value(const Item* sorted, int n, const int* take) {
+    double value = 0;
+    for (int i = 0; i < n; i++) {
+        if (take[i]) value += sorted[i].value;
+    }
+    return value;
+}
+
+// ƺʱ򣬲õ
+int compare_candidate(const void* a, const void* b) {
+    double ea = ((Candidate*)a)->estimated_ms;
+    double eb = ((Candidate*)b)->estimated_ms;
+    if (ea < 0 || eb < 0) return (ea < 0) - (eb < 0);
+    return (ea > eb) - (ea < eb);
+}
+
+//  0-1 max_gap Ϊ0 ʾҪŽ⣩
+// selected ԭʼƷ˳id - 1ѡreport ¼ѡ㷨Ͻ硣
+float solve(Item* items, int n, int capacity, double max_gap, int* selected, int* total_weight,
+            SolveReport* report) {
+    if (!cost_model_loaded) {
+        load_cost_model(&cost_model, CALIBRATION_FILE);
+        cost_model_loaded = 1;
+    }
+
+    Features f;
+    compute_features(items, n, capacity, &f);
+
+    Item* sorted = (Item*)malloc(n * sizeof(Item));
+    int* take = (int*)calloc(n, sizeof(int));
+    if (sorted == NULL || take == NULL) {
+        perror("ڴʧ");
+        exit(1);
+    }
+    memcpy(sorted, items, n * sizeof(Item));
+    qsort(sorted, n, sizeof(Item), compare);
+
+    // ̰Ľ LP Ͻ缸ѣҪֱӷأȫװʱҲŽ⣩
+    double upper_bound;
+    double value = greedy_with_bound(sorted, n, capacity, take, &upper_bound);
+    memset(report, 0, sizeof(SolveReport));
+    report->kind = SOLVER_GREEDY;
+    report->estimated_ms = estimate_ms(SOLVER_GREEDY, &f);
+    report->upper_bound = upper_bound;
+
+    double gap = upper_bound > 0 ? (upper_bound - value) / upper_bound : 0;
+    if (gap > max_gap) {
+        // ƺʱСγԣ֧޽糬ڵԤ㡢 DP ʱһ
+        Candidate candidates[] = {{SOLVER_MITM, 0}, {SOLVER_BNB, 0}, {SOLVER_DP, 0}, {SOLVER_CORE_DP, 0}};
+        int count = sizeof(candidates) / sizeof(candidates[0]);
+        for (int i = 0; i < count; i++) {
+            candidates[i].estimated_ms = estimate_ms(candidates[i].kind, &f);
+        }
+        // ҪŽʱ DP ֻΪоȷ㷨ʧֶܺ
+        qsort(candidates, max_gap > 0 ? count : count - 1, sizeof(Candidate), compare_candidate);
+
+        int* candidate = (int*)calloc(n, sizeof(int));
+        for (int i = 0; i < count; i++) {
+            SolverKind kind = candidates[i].kind;
+            if (candidates[i].estimated_ms < 0) continue;
+            float v;  // ֻжǷȽʱѡۼ
+            if (kind == SOLVER_MITM) {
+                v = knapsack_mitm(sorted, n, capacity, candidate);
+            } else if (kind == SOLVER_BNB) {
+                long long nodes;
+                double node_est = candidates[i].estimated_ms * 1e6 / cost_model.bnb_node_ns;
+                v = knapsack_bnb(sorted, n, capacity, candidate, (long long)(node_est * BNB_ABORT_FACTOR) + n, &nodes);
+            } else if (kind == SOLVER_DP) {
+                v = knapsack_dp_keep(sorted, n, capacity, candidate);
+            } else {
+                v = knapsack_core_dp(sorted, n, capacity, candidate);
+            }
+            if (v < 0) {
+                report->fallback = 1;
+                continue;
+            }
+            report->kind = kind;
+            report->estimated_ms = candidates[i].estimated_ms;
+            double candidate_value = selection_value(sorted, n, candidate);
+            if (candidate_value > value) {
+                value = candidate_value;
+                memcpy(take, candidate, n * sizeof(int));
+            }
+            if (kind != SOLVER_CORE_DP) {
+                report->upper_bound = value;  // ȷ㷨Ͻ缴ֵ
+                break;
+            }
+            if ((upper_bound - value) / upper_bound <= max_gap) break;
+            report->fallback = 1;
+        }
+        free(candidate);
+    }
+
+    memset(selected, 0, n * sizeof(int));
+    *total_weight = 0;
+    for (int i = 0; i < n; i++) {
+        if (take[i]) {
+            selected[sorted[i].id - 1] = 1;
+            *total_weight += sorted[i].weight;
+        }
+    }
+    report->value = selection_value(sorted, n, take);
+    value = report->value;
+    report->gap = report->upper_bound > 0 ? (report->upper_bound - value) / report->upper_bound : 0;
+
+    free(sorted);
+    free(take);
+    return (float)value;
+}
+
+void print_text(FILE* fp, int n, int capacity, int total_weight, const SolveReport* report, long long time_ms) {
+    fprintf(fp, "Ʒ: %d, : %d\n", n, capacity);
+    fprintf(fp, "㷨: %s%s, ƺʱ: %.2f ms\n", solver_names[report->kind],
+            report->fallback ? "ˣ" : "", report->estimated_ms);
+    fprintf(fp, "ֵܼ: %.2f, Ͻ: %.2f, : %.6f\n", report->value, report->upper_bound, report->gap);
+    fprintf(fp, ": %d\n", total_weight);
+    fprintf(fp, "ִʱ: %lld ms\n", time_ms);
+    fprintf(fp, "------------------------\n\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--calibrate") == 0) {
+        calibrate_cost_model(&cost_model);
+        save_cost_model(&cost_model, CALIBRATION_FILE);
+        printf("궨ɣsort %.3f ns, mitm %.3f ns, bnb %.3f ns/ڵ, dp %.3f ns/д %s\n",
+               cost_model.sort_ns, cost_model.mitm_ns, cost_model.bnb_node_ns, cost_model.dp_cell_ns,
+               CALIBRATION_FILE);
+        return 0;
+    }
+    double max_gap = argc > 1 ? atof(argv[1]) : 0.0;
+
+    srand((unsigned int)time(NULL));
+
+    int sizes[] = {20, 30, 1000, 2000, 3000, 4000, 5000, 6000, 7000, 8000, 9000, 10000,
+                   20000, 40000, 80000, 160000, 320000};
+    int sizes_count = sizeof(sizes) / sizeof(int);
+
+    FILE* fp_txt = fopen("solver_results.txt", "w");
+    if (fp_txt == NULL) {
+        perror("޷ļ");
+        return 1;
+    }
+
+    for (int si = 0; si < sizes_count; si++) {
+        int n = sizes[si];
+        Item* items = (Item*)malloc(n * sizeof(Item));
+        int* selected = (int*)calloc(n, sizeof(int));
+        generate_items(items, n);
+
+        for (int ci = 0; ci < CAPACITIES; ci++) {
+            int capacity = capacities[ci];
+            int total_weight = 0;
+            SolveReport report;
+
+            long long start = current_time_ms();
+            solve(items, n, capacity, max_gap, selected, &total_weight, &report);
+            long long end = current_time_ms();
+
+            print_text(fp_txt, n, capacity, total_weight, &report, end - start);
+        }
+
+        free(items);
+        free(selected);
+    }
+
+    fclose(fp_txt);
+    printf("ͳһɣд solver_results.txt\n");
+    return 0;
+}